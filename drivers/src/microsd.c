@@ -17,7 +17,8 @@
 
 /*******************************************************************************
 * The original version has been modified to include an option to double
-* the speed of the SPI clock when using a fast SD card.
+* the speed of the SPI clock when using a fast SD card, and to move data
+* blocks and card busy polling by DMA while the core sleeps in EM1.
 * openacousticdevices.info
 * March 2022
 *******************************************************************************/
@@ -25,7 +26,11 @@
 #include "diskio.h"
 #include "microsd.h"
 #include "em_cmu.h"
+#include "em_dma.h"
+#include "em_emu.h"
+#include "em_core.h"
 #include "em_usart.h"
+#include "dmactrl.h"
 
 /**************************************************************************//**
  * @addtogroup MicroSd
@@ -36,6 +41,107 @@
 static uint32_t timeOut, xfersPrMsec;
 static bool doubleSpiClkFast;
 
+#if MICROSD_USE_DMA
+static const uint16_t dummyTx = 0xFFFF;
+static uint8_t busyPollBuffer[MICROSD_BUSY_POLL_BYTES];
+
+/**************************************************************************//**
+ * @brief Make sure the DMA controller is running and configure the SPI
+ *        RX and TX channels. The controller may have been reset by the
+ *        microphone driver since the last transfer.
+ * @param size
+ *  Transfer unit size (dmaDataSize1 or dmaDataSize2).
+ * @param rxInc
+ *  Destination increment for the RX channel.
+ * @param txInc
+ *  Source increment for the TX channel.
+ *****************************************************************************/
+static void DmaConfigure(DMA_DataSize_TypeDef size, DMA_DataInc_TypeDef rxInc, DMA_DataInc_TypeDef txInc)
+{
+  DMA_CfgChannel_TypeDef chnlCfg;
+  DMA_CfgDescr_TypeDef descrCfg;
+
+  CMU_ClockEnable(cmuClock_DMA, true);
+
+  if (!(DMA->STATUS & DMA_STATUS_EN)) {
+    DMA_Init_TypeDef dmaInit;
+    dmaInit.hprot = 0;
+    dmaInit.controlBlock = dmaControlBlock;
+    DMA_Init(&dmaInit);
+  }
+
+  /* RX has priority so the receive buffer never overflows */
+  chnlCfg.highPri   = true;
+  chnlCfg.enableInt = true;
+  chnlCfg.select    = MICROSD_DMAREQ_RX;
+  chnlCfg.cb        = NULL;
+  DMA_CfgChannel(MICROSD_DMA_RX_CHANNEL, &chnlCfg);
+
+  chnlCfg.highPri   = false;
+  chnlCfg.select    = MICROSD_DMAREQ_TX;
+  DMA_CfgChannel(MICROSD_DMA_TX_CHANNEL, &chnlCfg);
+
+  descrCfg.size    = size;
+  descrCfg.arbRate = dmaArbitrate1;
+  descrCfg.hprot   = 0;
+
+  descrCfg.dstInc  = rxInc;
+  descrCfg.srcInc  = dmaDataIncNone;
+  DMA_CfgDescr(MICROSD_DMA_RX_CHANNEL, true, &descrCfg);
+
+  descrCfg.dstInc  = dmaDataIncNone;
+  descrCfg.srcInc  = txInc;
+  DMA_CfgDescr(MICROSD_DMA_TX_CHANNEL, true, &descrCfg);
+}
+
+/**************************************************************************//**
+ * @brief Sleep in EM1 until a DMA channel has completed its cycle. The
+ *        channel interrupt wakes the core, and interrupts are masked
+ *        around the check so the wake up cannot be missed.
+ * @param channel
+ *  DMA channel to wait for.
+ *****************************************************************************/
+static void DmaWait(unsigned int channel)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  while (DMA_ChannelEnabled(channel)) {
+    EMU_EnterEM1();
+    CORE_EXIT_ATOMIC();
+    CORE_ENTER_ATOMIC();
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/**************************************************************************//**
+ * @brief Clock out a burst of dummy bytes with the core asleep and return
+ *        the last byte received. Used while the card signals busy.
+ * @return Last byte received.
+ *****************************************************************************/
+static uint8_t DmaBusyPoll(void)
+{
+  DmaConfigure(dmaDataSize1, dmaDataInc1, dmaDataIncNone);
+
+  MICROSD_USART->CMD = USART_CMD_CLEARRX | USART_CMD_CLEARTX;
+
+  DMA_ActivateBasic(MICROSD_DMA_RX_CHANNEL, true, false, busyPollBuffer,
+                    (void *)&MICROSD_USART->RXDATA, MICROSD_BUSY_POLL_BYTES - 1);
+  DMA_ActivateBasic(MICROSD_DMA_TX_CHANNEL, true, false, (void *)&MICROSD_USART->TXDATA,
+                    &dummyTx, MICROSD_BUSY_POLL_BYTES - 1);
+
+  DmaWait(MICROSD_DMA_RX_CHANNEL);
+
+  if ( timeOut >= MICROSD_BUSY_POLL_BYTES ) {
+    timeOut -= MICROSD_BUSY_POLL_BYTES;
+  } else {
+    timeOut = 0;
+  }
+
+  return busyPollBuffer[MICROSD_BUSY_POLL_BYTES - 1];
+}
+#endif /* MICROSD_USE_DMA */
+
 /**************************************************************************//**
  * @brief Wait for micro SD card ready.
  * @return 0xff: micro SD card ready, other value: micro SD card not ready.
@@ -47,9 +153,23 @@ static uint8_t WaitReady(void)
 
   /* Wait for ready in timeout of 500ms */
   retryCount = 500 * xfersPrMsec;
-  do {
+
+  res = MICROSD_XferSpi(0xff);
+  if (res == 0xFF) {
+    return res;
+  }
+
+#if MICROSD_USE_DMA
+  /* Card is busy. Poll in bursts with the core sleeping in EM1 */
+  while ((res != 0xFF) && retryCount > MICROSD_BUSY_POLL_BYTES) {
+    res = DmaBusyPoll();
+    retryCount -= MICROSD_BUSY_POLL_BYTES;
+  }
+#endif
+
+  while ((res != 0xFF) && --retryCount) {
     res = MICROSD_XferSpi(0xff);
-  } while ((res != 0xFF) && --retryCount);
+  }
 
   return res;
 }
@@ -224,21 +344,40 @@ int MICROSD_BlockRx(uint8_t *buff, uint32_t btr)
     timeOut = 0;
   }
 
-  /* Pipelining - The USART has two buffers of 16 bit in both
-   * directions. Make sure that at least one is in the pipe at all
-   * times to maximize throughput. */
-  MICROSD_USART->TXDOUBLE = 0xffff;
-  do {
+#if MICROSD_USE_DMA
+  if (!((uint32_t)buff & 1)) {
+    /* The TX channel clocks out one extra word so that the CRC is
+     * left in the receive buffer when the RX channel completes. */
+    DmaConfigure(dmaDataSize2, dmaDataInc2, dmaDataIncNone);
+
+    DMA_ActivateBasic(MICROSD_DMA_RX_CHANNEL, true, false, buff,
+                      (void *)&MICROSD_USART->RXDOUBLE, btr / 2 - 1);
+    DMA_ActivateBasic(MICROSD_DMA_TX_CHANNEL, true, false, (void *)&MICROSD_USART->TXDOUBLE,
+                      &dummyTx, btr / 2);
+
+    DmaWait(MICROSD_DMA_RX_CHANNEL);
+
+    btr = 0;
+  }
+  if (btr)
+#endif
+  {
+    /* Pipelining - The USART has two buffers of 16 bit in both
+     * directions. Make sure that at least one is in the pipe at all
+     * times to maximize throughput. */
     MICROSD_USART->TXDOUBLE = 0xffff;
+    do {
+      MICROSD_USART->TXDOUBLE = 0xffff;
 
-    while (!(MICROSD_USART->STATUS & USART_STATUS_RXDATAV)) ;
+      while (!(MICROSD_USART->STATUS & USART_STATUS_RXDATAV)) ;
 
-    val = MICROSD_USART->RXDOUBLE;
-    *buff++ = val;
-    *buff++ = val >> 8;
+      val = MICROSD_USART->RXDOUBLE;
+      *buff++ = val;
+      *buff++ = val >> 8;
 
-    btr -= 2;
-  } while (btr);
+      btr -= 2;
+    } while (btr);
+  }
 
   /* Next two bytes is the CRC which we discard. */
   while (!(MICROSD_USART->STATUS & USART_STATUS_RXDATAV)) ;
@@ -294,17 +433,33 @@ int MICROSD_BlockTx(const uint8_t *buff, uint8_t token)
     timeOut = 0;
   }
 
-  do {
-    /* Transmit a 512 byte data block to the SD-Card. */
+#if MICROSD_USE_DMA
+  if (!((uint32_t)buff & 1)) {
+    /* Transmit a 512 byte data block to the SD-Card with the core asleep. */
+    DmaConfigure(dmaDataSize2, dmaDataIncNone, dmaDataInc2);
+
+    DMA_ActivateBasic(MICROSD_DMA_TX_CHANNEL, true, false, (void *)&MICROSD_USART->TXDOUBLE,
+                      buff, bc / 2 - 1);
 
-    val  = *buff++;
-    val |= *buff++ << 8;
-    bc  -= 2;
+    DmaWait(MICROSD_DMA_TX_CHANNEL);
 
-    while (!(MICROSD_USART->STATUS & USART_STATUS_TXBL)) ;
+    bc = 0;
+  }
+  if (bc)
+#endif
+  {
+    do {
+      /* Transmit a 512 byte data block to the SD-Card. */
 
-    MICROSD_USART->TXDOUBLE = val;
-  } while (bc);
+      val  = *buff++;
+      val |= *buff++ << 8;
+      bc  -= 2;
+
+      while (!(MICROSD_USART->STATUS & USART_STATUS_TXBL)) ;
+
+      MICROSD_USART->TXDOUBLE = val;
+    } while (bc);
+  }
 
   while (!(MICROSD_USART->STATUS & USART_STATUS_TXBL)) ;
 
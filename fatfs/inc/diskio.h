@@ -6,6 +6,7 @@
 
 #define _READONLY	0	/* 1: Remove write functions */
 #define _USE_IOCTL	1	/* 1: Use disk_ioctl function */
+#define _CACHE_SECTORS	8	/* Number of write-back cache sectors (0: Write through) */
 
 #include "integer.h"
 
@@ -21,6 +22,15 @@ typedef enum {
 	RES_PARERR		/* 4: Invalid Parameter */
 } DRESULT;
 
+/* Write-back cache counters (CTRL_CACHE_STATS) */
+typedef struct {
+	DWORD	hits;		/* Sector writes and reads served by the cache */
+	DWORD	misses;		/* Sector writes that allocated a cache sector */
+	DWORD	flushes;	/* Number of cache flushes */
+	DWORD	bursts;		/* Number of CMD24/CMD25 commands issued by flushes */
+	DWORD	sectors;	/* Number of sectors written by flushes */
+} CACHESTATS;
+
 
 /*---------------------------------------*/
 /* Prototypes for disk control functions. */
@@ -55,6 +65,7 @@ DRESULT disk_ioctl (BYTE, BYTE, void*);
 #define CTRL_LOCK			6	/* Lock/Unlock media removal */
 #define CTRL_EJECT			7	/* Eject media */
 #define CTRL_INVALIDATE 	8 /* Added by Silicon Labs */
+#define CTRL_CACHE_STATS	9	/* Get write-back cache counters (CACHESTATS) */
 
 
 /* MMC/SDC specific ioctl command */
@@ -11,12 +11,171 @@
 /
 /-------------------------------------------------------------------------*/
 
+#include <string.h>
+
 #include "microsd.h"
 #include "diskio.h"
+#include "trace.h"
 
 static DSTATUS stat = STA_NOINIT;  /* Disk status */
 static UINT CardType;
 
+#if _READONLY == 0 && _CACHE_SECTORS
+/* Write-back sector cache. Sector writes are held here until CTRL_SYNC
+/  (f_sync/f_close) or until the cache is full, then written in sector
+/  order with adjacent sectors merged into CMD25 bursts. */
+typedef struct {
+  DWORD sector;     /* Cached sector number (LBA) */
+  DWORD used;       /* Access stamp for LRU replacement */
+  BYTE  valid;      /* Line holds a sector */
+  BYTE  dirty;      /* Line differs from the card */
+} CACHELINE;
+
+static CACHELINE CacheLines[_CACHE_SECTORS];
+static BYTE CacheData[_CACHE_SECTORS][512] __attribute__ ((aligned(4)));
+static DWORD CacheStamp;
+static CACHESTATS CacheStats;
+#endif
+
+/*--------------------------------------------------------------------------
+
+   Private Functions
+
+---------------------------------------------------------------------------*/
+
+#if _READONLY == 0
+/*-----------------------------------------------------------------------*/
+/* Write consecutive sectors from a buffer or from cache lines           */
+/*-----------------------------------------------------------------------*/
+
+static DRESULT card_write (
+  DWORD sector,       /* Start sector number (LBA) */
+  const BYTE *buff,   /* Pointer to the data to be written or NULL */
+  const BYTE **lines, /* Per-sector data pointers when buff is NULL */
+  UINT count          /* Sector count (1..255) */
+)
+{
+  UINT n = 0;
+
+  if (!(CardType & CT_BLOCK)) sector *= 512;  /* Convert to byte address if needed */
+
+  if (count == 1) {                           /* Single block write */
+    if ((MICROSD_SendCmd(CMD24, sector) == 0) /* WRITE_BLOCK */
+      && MICROSD_BlockTx(buff ? buff : lines[0], 0xFE))
+      count = 0;
+  }
+  else {                                      /* Multiple block write */
+    if (CardType & CT_SDC) MICROSD_SendCmd(ACMD23, count);
+    if (MICROSD_SendCmd(CMD25, sector) == 0) {/* WRITE_MULTIPLE_BLOCK */
+      do {
+        if (!MICROSD_BlockTx(buff ? buff + 512 * n : lines[n], 0xFC)) break;
+        n++;
+      } while (--count);
+      if (!MICROSD_BlockTx(0, 0xFD))          /* STOP_TRAN token */
+        count = 1;
+    }
+  }
+  MICROSD_Deselect();
+
+  return count ? RES_ERROR : RES_OK;
+}
+#endif /* _READONLY */
+
+#if _READONLY == 0 && _CACHE_SECTORS
+/*-----------------------------------------------------------------------*/
+/* Find the cache line holding a sector                                  */
+/*-----------------------------------------------------------------------*/
+
+static int cache_find (
+  DWORD sector        /* Sector number (LBA) */
+)
+{
+  int i;
+
+  for (i = 0; i < _CACHE_SECTORS; i++) {
+    if (CacheLines[i].valid && CacheLines[i].sector == sector) return i;
+  }
+  return -1;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Write all dirty lines to the card in sector order                     */
+/*-----------------------------------------------------------------------*/
+
+static DRESULT cache_flush (void)
+{
+  const BYTE *run[_CACHE_SECTORS];
+  int order[_CACHE_SECTORS];
+  int i, j, k, n = 0;
+  DRESULT res = RES_OK;
+
+  for (i = 0; i < _CACHE_SECTORS; i++) {      /* Insertion sort dirty lines by sector */
+    if (!CacheLines[i].valid || !CacheLines[i].dirty) continue;
+    for (j = n; j > 0 && CacheLines[order[j - 1]].sector > CacheLines[i].sector; j--) order[j] = order[j - 1];
+    order[j] = i;
+    n++;
+  }
+  if (!n) return RES_OK;
+
+  CacheStats.flushes++;
+
+  for (i = 0; i < n; i = j) {                 /* Merge adjacent sectors into bursts */
+    for (j = i + 1; j < n && CacheLines[order[j]].sector == CacheLines[order[j - 1]].sector + 1; j++) ;
+    for (k = i; k < j; k++) run[k - i] = CacheData[order[k]];
+    if (card_write(CacheLines[order[i]].sector, 0, run, j - i) != RES_OK) {
+      res = RES_ERROR;
+      continue;
+    }
+    for (k = i; k < j; k++) CacheLines[order[k]].dirty = 0;
+    CacheStats.bursts++;
+    CacheStats.sectors += j - i;
+  }
+
+  return res;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Hold a sector write in the cache                                      */
+/*-----------------------------------------------------------------------*/
+
+static DRESULT cache_write (
+  const BYTE *buff,   /* Pointer to the data to be written */
+  DWORD sector        /* Sector number (LBA) */
+)
+{
+  int i, line = cache_find(sector);
+
+  if (line >= 0) {
+    CacheStats.hits++;
+  } else {
+    CacheStats.misses++;
+    for (i = 0; i < _CACHE_SECTORS && line < 0; i++) {
+      if (!CacheLines[i].valid) line = i;     /* Use a free line if there is one */
+    }
+    if (line < 0) {
+      for (i = 0; i < _CACHE_SECTORS; i++) {  /* Replace least recently used clean line */
+        if (!CacheLines[i].dirty && (line < 0 || CacheLines[i].used < CacheLines[line].used)) line = i;
+      }
+    }
+    if (line < 0) {                           /* Full of dirty lines */
+      if (cache_flush() != RES_OK) return RES_ERROR;
+      line = 0;
+      for (i = 1; i < _CACHE_SECTORS; i++) {  /* Replace least recently used */
+        if (CacheLines[i].used < CacheLines[line].used) line = i;
+      }
+    }
+    CacheLines[line].sector = sector;
+    CacheLines[line].valid = 1;
+  }
+
+  memcpy(CacheData[line], buff, 512);
+  CacheLines[line].dirty = 1;
+  CacheLines[line].used = ++CacheStamp;
+
+  return RES_OK;
+}
+#endif
+
 /*--------------------------------------------------------------------------
 
    Public Functions
@@ -36,6 +195,10 @@ DSTATUS disk_initialize (
   if (drv) return STA_NOINIT;                   /* Supports only single drive */
   if (stat & STA_NODISK) return stat;           /* No card in the socket */
 
+#if _READONLY == 0 && _CACHE_SECTORS
+  memset(CacheLines, 0, sizeof(CacheLines));    /* Drop any lines from a previous card session */
+#endif
+
   MICROSD_PowerOn();                            /* Force socket power on */
   MICROSD_SpiClkSlow();                         /* Start with low SPI clock. */
   for (n = 10; n; n--) MICROSD_XferSpi(0xff);   /* 80 dummy clocks */
@@ -103,6 +266,25 @@ DRESULT disk_read (
   if (drv || !count) return RES_PARERR;
   if (stat & STA_NOINIT) return RES_NOTRDY;
 
+#if _READONLY == 0 && _CACHE_SECTORS
+  int line;
+  BYTE n;
+
+  if (count == 1 && (line = cache_find(sector)) >= 0) {   /* Served from the cache */
+    memcpy(buff, CacheData[line], 512);
+    CacheStats.hits++;
+    return RES_OK;
+  }
+  for (n = 0; n < count; n++) {               /* Cached lines are newer than the card */
+    if (cache_find(sector + n) >= 0) break;
+  }
+  if (n < count) {
+    DRESULT res = RES_OK;
+    for (n = 0; n < count && res == RES_OK; n++) res = disk_read(drv, buff + 512 * n, sector + n, 1);
+    return res;
+  }
+#endif
+
   if (!(CardType & CT_BLOCK)) sector *= 512;  /* Convert to byte address if needed */
 
   if (count == 1) {                           /* Single block read */
@@ -140,27 +322,33 @@ DRESULT disk_write (
   if (stat & STA_NOINIT) return RES_NOTRDY;
   if (stat & STA_PROTECT) return RES_WRPRT;
 
-  if (!(CardType & CT_BLOCK)) sector *= 512;  /* Convert to byte address if needed */
+  TRACE_EVENT(TRACE_EVENT_DISK_WRITE_START, sector)
 
-  if (count == 1) {                           /* Single block write */
-    if ((MICROSD_SendCmd(CMD24, sector) == 0) /* WRITE_BLOCK */
-      && MICROSD_BlockTx(buff, 0xFE))
-      count = 0;
+#if _CACHE_SECTORS
+  int line;
+  BYTE n;
+
+  if (count < _CACHE_SECTORS) {               /* Hold short writes in the cache */
+    DRESULT res = RES_OK;
+    for (n = 0; n < count && res == RES_OK; n++) {
+      res = cache_write(buff + 512 * n, sector + n);
+    }
+    TRACE_EVENT(TRACE_EVENT_DISK_WRITE_END, count)    /* Every exit ends the event so the decoder pairs it */
+    return res;
   }
-  else {                                      /* Multiple block write */
-    if (CardType & CT_SDC) MICROSD_SendCmd(ACMD23, count);
-    if (MICROSD_SendCmd(CMD25, sector) == 0) {/* WRITE_MULTIPLE_BLOCK */
-      do {
-        if (!MICROSD_BlockTx(buff, 0xFC)) break;
-        buff += 512;
-      } while (--count);
-      if (!MICROSD_BlockTx(0, 0xFD))          /* STOP_TRAN token */
-        count = 1;
+  for (n = 0; n < count; n++) {               /* Long writes go straight to the card */
+    if ((line = cache_find(sector + n)) >= 0) {
+      memcpy(CacheData[line], buff + 512 * n, 512);
+      CacheLines[line].dirty = 0;
     }
   }
-  MICROSD_Deselect();
+#endif
 
-  return count ? RES_ERROR : RES_OK;
+  DRESULT res = card_write(sector, buff, 0, count);
+
+  TRACE_EVENT(TRACE_EVENT_DISK_WRITE_END, count)
+
+  return res;
 }
 #endif /* _READONLY */
 
@@ -185,6 +373,9 @@ DRESULT disk_ioctl (
   res = RES_ERROR;
   switch (ctrl) {
     case CTRL_SYNC :                /* Flush dirty buffer if present */
+#if _READONLY == 0 && _CACHE_SECTORS
+      if (cache_flush() != RES_OK) break;
+#endif
       if (MICROSD_Select()) {
         MICROSD_Deselect();
         res = RES_OK;
@@ -192,10 +383,20 @@ DRESULT disk_ioctl (
       break;
 
     case CTRL_INVALIDATE :          /* Used when unmounting */
+#if _READONLY == 0 && _CACHE_SECTORS
+      cache_flush();
+#endif
       stat = STA_NOINIT;            /* Set disk status */
       res = RES_OK;
       break;
 
+    case CTRL_CACHE_STATS :         /* Get write-back cache counters (CACHESTATS) */
+#if _READONLY == 0 && _CACHE_SECTORS
+      *(CACHESTATS*)buff = CacheStats;
+      res = RES_OK;
+#endif
+      break;
+
     case GET_SECTOR_COUNT :         /* Get number of sectors on the disk (WORD) */
       if ((MICROSD_SendCmd(CMD9, 0) == 0) && MICROSD_BlockRx(csd, 16)) {
         if ((csd[0] >> 6) == 1) {                     /* SDv2? */
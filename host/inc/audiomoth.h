@@ -0,0 +1,56 @@
+/****************************************************************************
+ * audiomoth.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __HOST_AUDIOMOTH_H
+#define __HOST_AUDIOMOTH_H
+
+/* Host build of the AudioMoth library. The prototypes come from the firmware header and the memory regions are arrays in hostmoth.c */
+
+#include_next "audiomoth.h"
+
+#include <stdint.h>
+
+extern uint32_t hostBackupDomain[AM_BACKUP_DOMAIN_SIZE_IN_REGISTERS];
+
+extern uint8_t hostFlashUserDataPage[AM_FLASH_USER_SIZE_IN_BYTES];
+
+extern uint8_t hostUniqueID[AM_UNIQUE_ID_SIZE_IN_BYTES];
+
+extern uint32_t hostExternalSRAM[AM_EXTERNAL_SRAM_SIZE_IN_BYTES / sizeof(uint32_t)];
+
+#undef AM_BACKUP_DOMAIN_START_ADDRESS
+#define AM_BACKUP_DOMAIN_START_ADDRESS         ((uintptr_t)hostBackupDomain)
+
+#undef AM_FLASH_USER_DATA_ADDRESS
+#define AM_FLASH_USER_DATA_ADDRESS             ((uintptr_t)hostFlashUserDataPage)
+
+#undef AM_UNIQUE_ID_START_ADDRESS
+#define AM_UNIQUE_ID_START_ADDRESS             ((uintptr_t)hostUniqueID)
+
+#undef AM_EXTERNAL_SRAM_START_ADDRESS
+#define AM_EXTERNAL_SRAM_START_ADDRESS         ((uintptr_t)hostExternalSRAM)
+
+/* Power down restarts the firmware so it never returns */
+
+void AudioMoth_powerDownAndWakeMilliseconds(uint32_t milliseconds) __attribute__((noreturn));
+
+/* Host simulation */
+
+int firmwareMain(void);
+
+bool Host_openWaveFile(char *filename, uint32_t startTime);
+
+void Host_setOutputDirectory(char *directory);
+
+void Host_stopCycleCounter(void);
+
+bool Host_loadConfiguration(char *filename);
+
+uint32_t Host_run(void);
+
+uint64_t Host_getSamplesProcessed(void);
+
+#endif /* __HOST_AUDIOMOTH_H */
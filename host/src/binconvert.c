@@ -0,0 +1,589 @@
+/****************************************************************************
+ * binconvert.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "crc.h"
+#include "peaks.h"
+#include "onsets.h"
+#include "mel.h"
+#include "classifier.h"
+#include "levels.h"
+#include "trigger.h"
+#include "noisefloor.h"
+#include "indices.h"
+#include "statistics.h"
+#include "spectrumfile.h"
+
+/* Converter constants */
+
+#define MAXIMUM_PATH_LENGTH                     1024
+#define MAXIMUM_THREADS                         256
+#define OUTPUT_BUFFER_SIZE                      (1 << 20)
+
+#define NPY_MAGIC                               "\x93NUMPY"
+#define NPY_ALIGNMENT                           64
+
+#define COLUMNAR_MAGIC                          "FFTC"
+#define COLUMNAR_VERSION                        1
+
+typedef enum {FORMAT_CSV, FORMAT_NPY, FORMAT_COLUMNAR} format_t;
+
+static const char *formatExtensions[] = {".csv", ".npy", ".col"};
+
+/* Columnar file header. The time and flags columns and then one column per bin follow it */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t binDecimation;
+    uint32_t numberOfRows;
+    uint32_t numberOfBins;
+    uint32_t sampleRate;
+    uint32_t fftLength;
+} columnarHeader_t;
+
+#pragma pack(pop)
+
+/* Conversion settings shared by all threads */
+
+static format_t format = FORMAT_CSV;
+
+static char *outputDirectory = ".";
+
+static uint32_t startTime = 0;
+
+static uint32_t endTime = UINT32_MAX;
+
+static uint32_t binDecimation = 1;
+
+/* File queue. Idle threads take the next file so long files do not hold up the others */
+
+static char **filenames;
+
+static uint32_t numberOfFiles;
+
+static uint32_t nextFile;
+
+static pthread_mutex_t printMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t numberOfFailures;
+
+/* Results of checking one file */
+
+typedef struct {
+    uint32_t numberOfRecords;
+    uint32_t numberOfSelected;
+    uint32_t numberOfInvalid;
+    uint32_t numberOfNonMonotonic;
+    uint32_t truncatedBytes;
+} fileStatistics_t;
+
+/* Record access */
+
+typedef struct {
+    const uint8_t *data;
+    const SF_header_t *header;
+    uint32_t numberOfFloats;
+    uint32_t numberOfBins;
+    bool hasIndices;
+    uint32_t indicesOffset;
+    uint32_t *selectedRecords;
+} spectrumFile_t;
+
+static const SF_recordHeader_t *getRecordHeader(spectrumFile_t *file, uint32_t record) {
+
+    return (const SF_recordHeader_t*)(file->data + SF_HEADER_SIZE + (uint64_t)record * file->header->recordSize);
+
+}
+
+static float getBin(spectrumFile_t *file, uint32_t record, uint32_t bin) {
+
+    /* Decimated bins sum the power of the bins they cover */
+
+    const uint8_t *payload = (const uint8_t*)getRecordHeader(file, record) + sizeof(SF_recordHeader_t);
+
+    float value = 0.0f;
+
+    for (uint32_t i = bin * binDecimation; i < (bin + 1) * binDecimation && i < file->numberOfFloats; i += 1) {
+
+        float sample;
+
+        memcpy(&sample, payload + i * sizeof(float), sizeof(float));
+
+        value += sample;
+
+    }
+
+    return value;
+
+}
+
+/* Validation */
+
+static bool isValidHeader(const SF_header_t *header, uint64_t fileSize) {
+
+    if (fileSize < SF_HEADER_SIZE || memcmp(header->magic, SF_MAGIC, sizeof(header->magic)) != 0) return false;
+
+    if (header->version != SF_VERSION || header->headerSize != SF_HEADER_SIZE) return false;
+
+    /* Sections follow each other in the order of their contents bits */
+
+    uint64_t payloadSize = 0;
+
+    if (header->contents & SF_CONTENTS_POWER_SPECTRUM) payloadSize += (uint64_t)header->numberOfBins * sizeof(float);
+
+    if (header->contents & SF_CONTENTS_ACOUSTIC_INDICES) payloadSize += sizeof(indices_t);
+
+    if (header->contents & SF_CONTENTS_SPECTRAL_STATISTICS) payloadSize += sizeof(statistics_t);
+
+    if (header->contents & SF_CONTENTS_SPECTRAL_PEAKS) payloadSize += sizeof(peaks_t);
+
+    if (header->contents & SF_CONTENTS_NOISE_FLOOR) payloadSize += sizeof(noiseFloorState_t);
+
+    if (header->contents & SF_CONTENTS_ONSETS) payloadSize += sizeof(onsets_t);
+
+    if (header->contents & SF_CONTENTS_MEL_FEATURES) payloadSize += sizeof(melFeatures_t);
+
+    if (header->contents & SF_CONTENTS_CLASSIFICATION) payloadSize += sizeof(classification_t);
+
+    if (header->contents & SF_CONTENTS_SOUND_LEVELS) payloadSize += sizeof(levels_t);
+
+    if (header->contents & SF_CONTENTS_TRIGGER) payloadSize += sizeof(trigger_t);
+
+    return payloadSize > 0 && header->recordSize >= sizeof(SF_recordHeader_t) + payloadSize;
+
+}
+
+static void selectRecords(spectrumFile_t *file, uint64_t fileSize, fileStatistics_t *statistics) {
+
+    uint32_t recordSize = file->header->recordSize;
+
+    uint32_t payloadSize = recordSize - sizeof(SF_recordHeader_t);
+
+    statistics->numberOfRecords = (fileSize - SF_HEADER_SIZE) / recordSize;
+
+    statistics->truncatedBytes = (fileSize - SF_HEADER_SIZE) % recordSize;
+
+    bool hasPreviousTime = false;
+
+    uint32_t previousTime = 0;
+
+    for (uint32_t i = 0; i < statistics->numberOfRecords; i += 1) {
+
+        SF_recordHeader_t recordHeader;
+
+        memcpy(&recordHeader, getRecordHeader(file, i), sizeof(SF_recordHeader_t));
+
+        uint16_t crc = CRC_update(0, (uint8_t*)&recordHeader, offsetof(SF_recordHeader_t, crc));
+
+        crc = CRC_update(crc, (const uint8_t*)getRecordHeader(file, i) + sizeof(SF_recordHeader_t), payloadSize);
+
+        if (!(recordHeader.flags & SF_FLAG_VALID) || crc != recordHeader.crc) {
+
+            statistics->numberOfInvalid += 1;
+
+            continue;
+
+        }
+
+        /* Records which go back in time are reported but kept */
+
+        if (hasPreviousTime && recordHeader.time <= previousTime) statistics->numberOfNonMonotonic += 1;
+
+        hasPreviousTime = true;
+
+        previousTime = recordHeader.time;
+
+        if (recordHeader.time < startTime || recordHeader.time > endTime) continue;
+
+        file->selectedRecords[statistics->numberOfSelected++] = i;
+
+    }
+
+}
+
+/* Output writers */
+
+static void writeCSV(FILE *output, spectrumFile_t *file, uint32_t numberOfRows) {
+
+    fprintf(output, "time,flags");
+
+    if (file->hasIndices) fprintf(output, ",aci,adi,bi,ndsi,spectral_entropy,temporal_entropy");
+
+    for (uint32_t bin = 0; bin < file->numberOfBins; bin += 1) fprintf(output, ",bin%u", bin * binDecimation);
+
+    fprintf(output, "\n");
+
+    for (uint32_t row = 0; row < numberOfRows; row += 1) {
+
+        uint32_t record = file->selectedRecords[row];
+
+        const SF_recordHeader_t *recordHeader = getRecordHeader(file, record);
+
+        fprintf(output, "%u,%u", recordHeader->time, recordHeader->flags);
+
+        if (file->hasIndices) {
+
+            indices_t indices;
+
+            memcpy(&indices, (const uint8_t*)recordHeader + file->indicesOffset, sizeof(indices_t));
+
+            fprintf(output, ",%.9g,%.9g,%.9g,%.9g,%.9g,%.9g", indices.acousticComplexity, indices.acousticDiversity, indices.bioacoustic, indices.normalisedDifference, indices.spectralEntropy, indices.temporalEntropy);
+
+        }
+
+        for (uint32_t bin = 0; bin < file->numberOfBins; bin += 1) fprintf(output, ",%.9g", getBin(file, record, bin));
+
+        fprintf(output, "\n");
+
+    }
+
+}
+
+static void writeNPY(FILE *output, spectrumFile_t *file, uint32_t numberOfRows) {
+
+    /* A structured array with one row per record */
+
+    char description[256];
+
+    int length = snprintf(description, sizeof(description), "{'descr': [('time', '<u4'), ('flags', '<u2'), ('power', '<f4', (%u,))], 'fortran_order': False, 'shape': (%u,), }", file->numberOfBins, numberOfRows);
+
+    uint32_t preambleSize = strlen(NPY_MAGIC) + 2 + sizeof(uint16_t);
+
+    uint16_t headerLength = (preambleSize + length + 1 + NPY_ALIGNMENT - 1) / NPY_ALIGNMENT * NPY_ALIGNMENT - preambleSize;
+
+    fwrite(NPY_MAGIC "\x01\x00", 1, preambleSize - sizeof(uint16_t), output);
+
+    fwrite(&headerLength, sizeof(uint16_t), 1, output);
+
+    fprintf(output, "%-*s\n", headerLength - 1, description);
+
+    for (uint32_t row = 0; row < numberOfRows; row += 1) {
+
+        uint32_t record = file->selectedRecords[row];
+
+        const SF_recordHeader_t *recordHeader = getRecordHeader(file, record);
+
+        fwrite(&recordHeader->time, sizeof(uint32_t), 1, output);
+
+        fwrite(&recordHeader->flags, sizeof(uint16_t), 1, output);
+
+        for (uint32_t bin = 0; bin < file->numberOfBins; bin += 1) {
+
+            float value = getBin(file, record, bin);
+
+            fwrite(&value, sizeof(float), 1, output);
+
+        }
+
+    }
+
+}
+
+static void writeColumnar(FILE *output, spectrumFile_t *file, uint32_t numberOfRows) {
+
+    columnarHeader_t header = {.version = COLUMNAR_VERSION, .binDecimation = binDecimation, .numberOfRows = numberOfRows, .numberOfBins = file->numberOfBins, .sampleRate = file->header->sampleRate, .fftLength = file->header->fftLength};
+
+    memcpy(header.magic, COLUMNAR_MAGIC, sizeof(header.magic));
+
+    fwrite(&header, sizeof(columnarHeader_t), 1, output);
+
+    for (uint32_t row = 0; row < numberOfRows; row += 1) fwrite(&getRecordHeader(file, file->selectedRecords[row])->time, sizeof(uint32_t), 1, output);
+
+    for (uint32_t row = 0; row < numberOfRows; row += 1) fwrite(&getRecordHeader(file, file->selectedRecords[row])->flags, sizeof(uint16_t), 1, output);
+
+    /* The flags column is padded so the bin columns stay aligned */
+
+    if (numberOfRows % 2) fwrite("\0\0", 1, sizeof(uint16_t), output);
+
+    for (uint32_t bin = 0; bin < file->numberOfBins; bin += 1) {
+
+        for (uint32_t row = 0; row < numberOfRows; row += 1) {
+
+            float value = getBin(file, file->selectedRecords[row], bin);
+
+            fwrite(&value, sizeof(float), 1, output);
+
+        }
+
+    }
+
+}
+
+/* Output names. Each output takes the name of its input without the directory or extension */
+
+static char *outputName(char *filename, int *length) {
+
+    char *basename = strrchr(filename, '/');
+
+    basename = basename ? basename + 1 : filename;
+
+    char *extension = strrchr(basename, '.');
+
+    *length = extension ? extension - basename : (int)strlen(basename);
+
+    return basename;
+
+}
+
+static int compareOutputNames(const void *first, const void *second) {
+
+    int firstLength, secondLength;
+
+    char *firstName = outputName(*(char**)first, &firstLength);
+
+    char *secondName = outputName(*(char**)second, &secondLength);
+
+    int result = strncmp(firstName, secondName, firstLength < secondLength ? firstLength : secondLength);
+
+    return result != 0 ? result : firstLength - secondLength;
+
+}
+
+static bool findDuplicateOutputs(void) {
+
+    /* Devices name their files by time, so inputs from different directories often share a name and would overwrite each other */
+
+    char **sortedFilenames = malloc(sizeof(char*) * numberOfFiles);
+
+    if (sortedFilenames == NULL) return true;
+
+    memcpy(sortedFilenames, filenames, sizeof(char*) * numberOfFiles);
+
+    qsort(sortedFilenames, numberOfFiles, sizeof(char*), compareOutputNames);
+
+    bool duplicate = false;
+
+    for (uint32_t i = 1; i < numberOfFiles; i += 1) {
+
+        if (compareOutputNames(sortedFilenames + i - 1, sortedFilenames + i) == 0) {
+
+            printf("%s and %s would both be written to the same output file\n", sortedFilenames[i - 1], sortedFilenames[i]);
+
+            duplicate = true;
+
+        }
+
+    }
+
+    free(sortedFilenames);
+
+    return duplicate;
+
+}
+
+/* Convert one file */
+
+static bool outputPath(char *filename, char *path) {
+
+    int length;
+
+    char *basename = outputName(filename, &length);
+
+    return snprintf(path, MAXIMUM_PATH_LENGTH, "%s/%.*s%s", outputDirectory, length, basename, formatExtensions[format]) < MAXIMUM_PATH_LENGTH;
+
+}
+
+static bool convertFile(char *filename, fileStatistics_t *statistics) {
+
+    int descriptor = open(filename, O_RDONLY);
+
+    if (descriptor < 0) return false;
+
+    struct stat fileStatus;
+
+    if (fstat(descriptor, &fileStatus) != 0 || fileStatus.st_size < SF_HEADER_SIZE) {
+
+        close(descriptor);
+
+        return false;
+
+    }
+
+    void *data = mmap(NULL, fileStatus.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    close(descriptor);
+
+    if (data == MAP_FAILED) return false;
+
+    madvise(data, fileStatus.st_size, MADV_SEQUENTIAL);
+
+    spectrumFile_t file = {.data = data, .header = data};
+
+    bool success = isValidHeader(file.header, fileStatus.st_size);
+
+    if (success) {
+
+        file.numberOfFloats = file.header->contents & SF_CONTENTS_POWER_SPECTRUM ? file.header->numberOfBins : 0;
+
+        file.hasIndices = file.header->contents & SF_CONTENTS_ACOUSTIC_INDICES;
+
+        file.indicesOffset = sizeof(SF_recordHeader_t) + file.numberOfFloats * sizeof(float);
+
+        file.numberOfBins = (file.numberOfFloats + binDecimation - 1) / binDecimation;
+
+        file.selectedRecords = malloc(sizeof(uint32_t) * ((fileStatus.st_size - SF_HEADER_SIZE) / file.header->recordSize + 1));
+
+        success = file.selectedRecords != NULL;
+
+    }
+
+    if (success) selectRecords(&file, fileStatus.st_size, statistics);
+
+    char path[MAXIMUM_PATH_LENGTH];
+
+    FILE *output = success && outputPath(filename, path) ? fopen(path, "wb") : NULL;
+
+    if (output) {
+
+        setvbuf(output, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+
+        if (format == FORMAT_CSV) writeCSV(output, &file, statistics->numberOfSelected);
+
+        if (format == FORMAT_NPY) writeNPY(output, &file, statistics->numberOfSelected);
+
+        if (format == FORMAT_COLUMNAR) writeColumnar(output, &file, statistics->numberOfSelected);
+
+        success = fclose(output) == 0;
+
+    } else {
+
+        success = false;
+
+    }
+
+    free(file.selectedRecords);
+
+    munmap(data, fileStatus.st_size);
+
+    return success;
+
+}
+
+static void *workerThread(void *argument) {
+
+    while (true) {
+
+        uint32_t index = __atomic_fetch_add(&nextFile, 1, __ATOMIC_RELAXED);
+
+        if (index >= numberOfFiles) break;
+
+        fileStatistics_t statistics = {0};
+
+        bool success = convertFile(filenames[index], &statistics);
+
+        pthread_mutex_lock(&printMutex);
+
+        if (success) {
+
+            printf("%s: %u records, %u written, %u invalid, %u out of order, %u truncated bytes\n", filenames[index], statistics.numberOfRecords, statistics.numberOfSelected, statistics.numberOfInvalid, statistics.numberOfNonMonotonic, statistics.truncatedBytes);
+
+        } else {
+
+            printf("%s: FAILED\n", filenames[index]);
+
+            numberOfFailures += 1;
+
+        }
+
+        pthread_mutex_unlock(&printMutex);
+
+    }
+
+    return NULL;
+
+}
+
+/* Main function */
+
+int main(int argc, char **argv) {
+
+    uint32_t numberOfThreads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    int i = 1;
+
+    for (; i < argc && argv[i][0] == '-'; i += 1) {
+
+        if (i + 1 == argc) break;
+
+        char *value = argv[++i];
+
+        if (strcmp(argv[i - 1], "-f") == 0) {
+
+            format = strcmp(value, "npy") == 0 ? FORMAT_NPY : strcmp(value, "col") == 0 ? FORMAT_COLUMNAR : FORMAT_CSV;
+
+        } else if (strcmp(argv[i - 1], "-o") == 0) {
+
+            outputDirectory = value;
+
+        } else if (strcmp(argv[i - 1], "-s") == 0) {
+
+            startTime = strtoul(value, NULL, 10);
+
+        } else if (strcmp(argv[i - 1], "-e") == 0) {
+
+            endTime = strtoul(value, NULL, 10);
+
+        } else if (strcmp(argv[i - 1], "-d") == 0) {
+
+            binDecimation = strtoul(value, NULL, 10);
+
+        } else if (strcmp(argv[i - 1], "-j") == 0) {
+
+            numberOfThreads = strtoul(value, NULL, 10);
+
+        }
+
+    }
+
+    if (i == argc || binDecimation == 0 || binDecimation > UINT16_MAX) {
+
+        printf("Usage: %s [-f csv | npy | col] [-o DIRECTORY] [-s START_TIME] [-e END_TIME] [-d BIN_DECIMATION] [-j THREADS] FILE.BIN ...\n", argv[0]);
+
+        return 1;
+
+    }
+
+    filenames = argv + i;
+
+    numberOfFiles = argc - i;
+
+    if (findDuplicateOutputs()) {
+
+        printf("Convert files which share a name into separate output directories\n");
+
+        return 1;
+
+    }
+
+    if (numberOfThreads == 0) numberOfThreads = 1;
+
+    if (numberOfThreads > MAXIMUM_THREADS) numberOfThreads = MAXIMUM_THREADS;
+
+    if (numberOfThreads > numberOfFiles) numberOfThreads = numberOfFiles;
+
+    pthread_t threads[MAXIMUM_THREADS];
+
+    for (uint32_t j = 0; j < numberOfThreads; j += 1) pthread_create(threads + j, NULL, workerThread, NULL);
+
+    for (uint32_t j = 0; j < numberOfThreads; j += 1) pthread_join(threads[j], NULL);
+
+    return numberOfFailures > 0 ? 1 : 0;
+
+}
@@ -0,0 +1,220 @@
+/****************************************************************************
+ * classifierbench.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_CYCLE_COUNTER                       true
+#else
+#define HAS_CYCLE_COUNTER                       false
+#endif
+
+#include "mel.h"
+#include "classifier.h"
+#include "classifier_model.h"
+
+/* Benchmark constants */
+
+#define NUMBER_OF_TEST_VECTORS                  1000
+#define NUMBER_OF_TIMED_INFERENCES              200000
+#define MINIMUM_LEVEL                           -110.0f
+#define MAXIMUM_LEVEL                           -10.0f
+
+/* Accuracy gate. The int8 model should follow the same weights in floating point closely */
+
+#define MAXIMUM_PROBABILITY_ERROR               0.1
+#define MAXIMUM_DECISION_ERRORS                 0.02
+
+/* Cortex-M4 cost model. SMLAD takes two multiply-accumulates and each word also needs two loads and four extracts */
+
+#define M4_CYCLES_PER_WORD                      8
+#define M4_CYCLES_PER_OUTPUT                    30
+#define M4_CLOCK_FREQUENCY                      12000000.0
+
+/* Test vectors */
+
+static float inputs[NUMBER_OF_TEST_VECTORS][MEL_NUMBER_OF_BANDS];
+
+/* Floating point reference using the quantised weights but unquantised activations */
+
+static float referencePredict(float *input) {
+
+    const classifierHeader_t *header = (const classifierHeader_t*)classifierModel;
+
+    const uint8_t *position = (const uint8_t*)classifierModel + sizeof(classifierHeader_t);
+
+    float current[CLASSIFIER_MAXIMUM_WIDTH], next[CLASSIFIER_MAXIMUM_WIDTH];
+
+    for (uint32_t i = 0; i < header->numberOfInputs; i += 1) current[i] = input[i] - header->inputOffset;
+
+    uint8_t activation = CLASSIFIER_ACTIVATION_NONE;
+
+    for (uint32_t l = 0; l < header->numberOfLayers; l += 1) {
+
+        const classifierLayer_t *layer = (const classifierLayer_t*)position;
+
+        const int32_t *biases = (const int32_t*)(position + sizeof(classifierLayer_t));
+
+        const int8_t *weights = (const int8_t*)(biases + layer->numberOfOutputs);
+
+        for (uint32_t o = 0; o < layer->numberOfOutputs; o += 1) {
+
+            float sum = (float)biases[o] * layer->inputScale * layer->weightScale;
+
+            for (uint32_t i = 0; i < layer->numberOfInputs; i += 1) sum += (float)weights[o * layer->rowLength + i] * layer->weightScale * current[i];
+
+            next[o] = layer->activation == CLASSIFIER_ACTIVATION_RELU && sum < 0.0f ? 0.0f : sum;
+
+        }
+
+        memcpy(current, next, layer->numberOfOutputs * sizeof(float));
+
+        activation = layer->activation;
+
+        position = (const uint8_t*)weights + layer->numberOfOutputs * layer->rowLength;
+
+    }
+
+    return activation == CLASSIFIER_ACTIVATION_LOGISTIC ? 1.0f / (1.0f + expf(-current[0])) : current[0];
+
+}
+
+static void generateInputs(void) {
+
+    /* Random spectra, half of them with a raised block of bands so both classes are exercised */
+
+    srand(1);
+
+    for (uint32_t n = 0; n < NUMBER_OF_TEST_VECTORS; n += 1) {
+
+        float background = MINIMUM_LEVEL + (MAXIMUM_LEVEL - MINIMUM_LEVEL) * (float)rand() / (float)RAND_MAX;
+
+        uint32_t start = rand() % MEL_NUMBER_OF_BANDS, width = n % 2 ? 4 + rand() % 12 : 0;
+
+        for (uint32_t m = 0; m < MEL_NUMBER_OF_BANDS; m += 1) {
+
+            float level = background + 6.0f * ((float)rand() / (float)RAND_MAX - 0.5f);
+
+            if (m >= start && m < start + width) level += 10.0f + 30.0f * (float)rand() / (float)RAND_MAX;
+
+            inputs[n][m] = fminf(0.0f, level);
+
+        }
+
+    }
+
+}
+
+static double elapsedNanoseconds(struct timespec *start, struct timespec *end) {
+
+    return 1e9 * (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec);
+
+}
+
+/* Main function */
+
+int main(void) {
+
+    if (!Classifier_initialise(classifierModel, MEL_NUMBER_OF_BANDS)) {
+
+        printf("Model is not valid for %u inputs\n", MEL_NUMBER_OF_BANDS);
+
+        return 1;
+
+    }
+
+    generateInputs();
+
+    /* Accuracy against the floating point reference */
+
+    double maximumError = 0.0;
+
+    uint32_t decisionErrors = 0, positives = 0;
+
+    for (uint32_t n = 0; n < NUMBER_OF_TEST_VECTORS; n += 1) {
+
+        float probability = Classifier_predict(inputs[n]);
+
+        float reference = referencePredict(inputs[n]);
+
+        maximumError = fmax(maximumError, fabs(probability - reference));
+
+        if ((probability > CLASSIFIER_THRESHOLD) != (reference > CLASSIFIER_THRESHOLD)) decisionErrors += 1;
+
+        if (reference > CLASSIFIER_THRESHOLD) positives += 1;
+
+    }
+
+    /* Timing on the host */
+
+    struct timespec start, end;
+
+    volatile float sink = 0.0f;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+#if HAS_CYCLE_COUNTER
+    uint64_t startCycles = __rdtsc();
+#endif
+
+    for (uint32_t i = 0; i < NUMBER_OF_TIMED_INFERENCES; i += 1) sink += Classifier_predict(inputs[i % NUMBER_OF_TEST_VECTORS]);
+
+#if HAS_CYCLE_COUNTER
+    uint64_t cycles = __rdtsc() - startCycles;
+#endif
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    /* Estimate of the cost on the device from the shape of the model */
+
+    const classifierHeader_t *header = (const classifierHeader_t*)classifierModel;
+
+    const uint8_t *position = (const uint8_t*)classifierModel + sizeof(classifierHeader_t);
+
+    uint32_t multiplyAccumulates = 0, estimatedCycles = 0;
+
+    for (uint32_t l = 0; l < header->numberOfLayers; l += 1) {
+
+        const classifierLayer_t *layer = (const classifierLayer_t*)position;
+
+        multiplyAccumulates += layer->numberOfOutputs * layer->rowLength;
+
+        estimatedCycles += layer->numberOfOutputs * (M4_CYCLES_PER_WORD * layer->rowLength / 4 + M4_CYCLES_PER_OUTPUT);
+
+        position += sizeof(classifierLayer_t) + layer->numberOfOutputs * (sizeof(int32_t) + layer->rowLength);
+
+    }
+
+    bool success = maximumError <= MAXIMUM_PROBABILITY_ERROR && decisionErrors <= MAXIMUM_DECISION_ERRORS * NUMBER_OF_TEST_VECTORS;
+
+    printf("Model:            %u layers, %u bytes, %u multiply-accumulates\n", header->numberOfLayers, header->size, multiplyAccumulates);
+
+    printf("Test vectors:     %u, %u positive\n", NUMBER_OF_TEST_VECTORS, positives);
+
+    printf("Maximum error:    %.4f\n", maximumError);
+
+    printf("Decision errors:  %u  %s\n", decisionErrors, success ? "ok" : "FAIL");
+
+    printf("Host:             %.1f ns per inference", elapsedNanoseconds(&start, &end) / NUMBER_OF_TIMED_INFERENCES);
+
+#if HAS_CYCLE_COUNTER
+    printf(", %.0f TSC cycles per inference", (double)cycles / NUMBER_OF_TIMED_INFERENCES);
+#endif
+
+    printf("\n");
+
+    printf("Cortex-M4:        about %u cycles per inference, %.2f ms at 12 MHz\n", estimatedCycles, 1000.0 * estimatedCycles / M4_CLOCK_FREQUENCY);
+
+    return success ? 0 : 1;
+
+}
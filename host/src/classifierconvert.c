@@ -0,0 +1,353 @@
+/****************************************************************************
+ * classifierconvert.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "classifier.h"
+
+/* Converter constants */
+
+#define MAXIMUM_MODEL_SIZE                      (64 * 1024)
+#define MAXIMUM_TOKEN_LENGTH                    64
+#define MAXIMUM_WEIGHT                          127
+#define WORDS_PER_LINE                          6
+
+/* Model being built */
+
+static uint8_t model[MAXIMUM_MODEL_SIZE] __attribute__ ((aligned(4)));
+
+static uint32_t modelSize;
+
+static float weights[CLASSIFIER_MAXIMUM_WIDTH * CLASSIFIER_MAXIMUM_WIDTH];
+
+static float biases[CLASSIFIER_MAXIMUM_WIDTH];
+
+/* Text input. Tokens are separated by white space and a hash starts a comment */
+
+static bool readToken(FILE *input, char *token) {
+
+    while (fscanf(input, "%63s", token) == 1) {
+
+        if (token[0] != '#') return true;
+
+        int c;
+
+        while ((c = fgetc(input)) != EOF && c != '\n');
+
+    }
+
+    return false;
+
+}
+
+static bool readNumber(FILE *input, float *value) {
+
+    char token[MAXIMUM_TOKEN_LENGTH];
+
+    char *end;
+
+    if (!readToken(input, token)) return false;
+
+    *value = strtof(token, &end);
+
+    return *end == 0;
+
+}
+
+static bool expectToken(FILE *input, const char *expected) {
+
+    char token[MAXIMUM_TOKEN_LENGTH];
+
+    return readToken(input, token) && strcmp(token, expected) == 0;
+
+}
+
+/* Quantisation */
+
+static int32_t roundAndClip(double value, double limit) {
+
+    return (int32_t)lround(value > limit ? limit : value < -limit ? -limit : value);
+
+}
+
+static bool appendLayer(uint32_t numberOfInputs, uint32_t numberOfOutputs, uint8_t activation, float inputRange) {
+
+    /* Weights share one scale per layer and the biases are in units of the product of the input and weight scales */
+
+    float maximumWeight = 0.0f;
+
+    for (uint32_t i = 0; i < numberOfInputs * numberOfOutputs; i += 1) maximumWeight = fmaxf(maximumWeight, fabsf(weights[i]));
+
+    classifierLayer_t layer;
+
+    layer.numberOfInputs = numberOfInputs;
+
+    layer.numberOfOutputs = numberOfOutputs;
+
+    layer.rowLength = (numberOfInputs + 3) & ~3;
+
+    layer.activation = activation;
+
+    layer.reserved = 0;
+
+    layer.inputScale = inputRange / MAXIMUM_WEIGHT;
+
+    layer.weightScale = maximumWeight > 0.0f ? maximumWeight / MAXIMUM_WEIGHT : 1.0f;
+
+    uint32_t layerSize = sizeof(classifierLayer_t) + numberOfOutputs * (sizeof(int32_t) + layer.rowLength);
+
+    if (modelSize + layerSize > MAXIMUM_MODEL_SIZE) return false;
+
+    memcpy(model + modelSize, &layer, sizeof(classifierLayer_t));
+
+    int32_t *quantisedBiases = (int32_t*)(model + modelSize + sizeof(classifierLayer_t));
+
+    int8_t *quantisedWeights = (int8_t*)(quantisedBiases + numberOfOutputs);
+
+    for (uint32_t o = 0; o < numberOfOutputs; o += 1) {
+
+        quantisedBiases[o] = roundAndClip(biases[o] / ((double)layer.inputScale * layer.weightScale), INT32_MAX);
+
+        for (uint32_t i = 0; i < layer.rowLength; i += 1) {
+
+            quantisedWeights[o * layer.rowLength + i] = i < numberOfInputs ? roundAndClip(weights[o * numberOfInputs + i] / layer.weightScale, MAXIMUM_WEIGHT) : 0;
+
+        }
+
+    }
+
+    modelSize += layerSize;
+
+    return true;
+
+}
+
+static bool readModel(FILE *input) {
+
+    /* The model starts with the number of inputs and the offset removed from them, followed by each dense layer */
+
+    float numberOfInputs, inputOffset;
+
+    if (!expectToken(input, "inputs") || !readNumber(input, &numberOfInputs) || !expectToken(input, "offset") || !readNumber(input, &inputOffset)) return false;
+
+    classifierHeader_t header;
+
+    memcpy(header.magic, CLASSIFIER_MAGIC, sizeof(header.magic));
+
+    header.version = CLASSIFIER_VERSION;
+
+    header.numberOfLayers = 0;
+
+    header.numberOfInputs = (uint16_t)numberOfInputs;
+
+    header.reserved = 0;
+
+    header.inputOffset = inputOffset;
+
+    modelSize = sizeof(classifierHeader_t);
+
+    uint32_t layerInputs = header.numberOfInputs;
+
+    char token[MAXIMUM_TOKEN_LENGTH];
+
+    while (readToken(input, token)) {
+
+        /* Each layer gives its width, its activation and the largest magnitude expected at its input, followed by the weight rows and the biases */
+
+        float numberOfOutputs, inputRange;
+
+        char activationName[MAXIMUM_TOKEN_LENGTH];
+
+        if (strcmp(token, "dense") != 0 || !readNumber(input, &numberOfOutputs) || !readToken(input, activationName) || !expectToken(input, "range") || !readNumber(input, &inputRange)) return false;
+
+        uint8_t activation = strcmp(activationName, "relu") == 0 ? CLASSIFIER_ACTIVATION_RELU : strcmp(activationName, "logistic") == 0 ? CLASSIFIER_ACTIVATION_LOGISTIC : CLASSIFIER_ACTIVATION_NONE;
+
+        if (numberOfOutputs < 1 || numberOfOutputs > CLASSIFIER_MAXIMUM_WIDTH || layerInputs > CLASSIFIER_MAXIMUM_WIDTH || inputRange <= 0.0f) return false;
+
+        if (header.numberOfLayers == CLASSIFIER_MAXIMUM_NUMBER_OF_LAYERS) return false;
+
+        uint32_t outputs = (uint32_t)numberOfOutputs;
+
+        for (uint32_t i = 0; i < outputs * layerInputs; i += 1) if (!readNumber(input, weights + i)) return false;
+
+        for (uint32_t i = 0; i < outputs; i += 1) if (!readNumber(input, biases + i)) return false;
+
+        if (!appendLayer(layerInputs, outputs, activation, inputRange)) return false;
+
+        header.numberOfLayers += 1;
+
+        layerInputs = outputs;
+
+    }
+
+    if (header.numberOfLayers == 0 || layerInputs != 1) return false;
+
+    header.size = modelSize;
+
+    memcpy(model, &header, sizeof(classifierHeader_t));
+
+    return true;
+
+}
+
+/* Output */
+
+static bool writeHeaderFile(char *filename, char *source) {
+
+    FILE *output = fopen(filename, "w");
+
+    if (output == NULL) return false;
+
+    fprintf(output, "/****************************************************************************\n");
+
+    fprintf(output, " * %s\n", strrchr(filename, '/') ? strrchr(filename, '/') + 1 : filename);
+
+    fprintf(output, " * openacousticdevices.info\n");
+
+    fprintf(output, " * November 2024\n");
+
+    fprintf(output, " *****************************************************************************/\n\n");
+
+    fprintf(output, "#include <stdint.h>\n\n");
+
+    fprintf(output, "/* Classifier model converted by host/bin/classifierconvert from %s */\n\n", strrchr(source, '/') ? strrchr(source, '/') + 1 : source);
+
+    fprintf(output, "static const uint32_t classifierModel[%u] = {\n", modelSize / 4);
+
+    for (uint32_t i = 0; i < modelSize / 4; i += 1) {
+
+        uint32_t word;
+
+        memcpy(&word, model + 4 * i, sizeof(uint32_t));
+
+        fprintf(output, "%s0x%08X%s", i % WORDS_PER_LINE == 0 ? "    " : "", word, i == modelSize / 4 - 1 ? "\n" : i % WORDS_PER_LINE == WORDS_PER_LINE - 1 ? ",\n" : ", ");
+
+    }
+
+    fprintf(output, "};\n");
+
+    fclose(output);
+
+    return true;
+
+}
+
+static bool writeBinaryFile(char *filename) {
+
+    FILE *output = fopen(filename, "wb");
+
+    if (output == NULL) return false;
+
+    bool success = fwrite(model, 1, modelSize, output) == modelSize;
+
+    fclose(output);
+
+    return success;
+
+}
+
+/* Main function */
+
+int main(int argc, char **argv) {
+
+    char *headerFilename = NULL, *binaryFilename = NULL;
+
+    int i = 1;
+
+    for (; i < argc && argv[i][0] == '-'; i += 1) {
+
+        if (i + 1 == argc) break;
+
+        char *value = argv[++i];
+
+        if (strcmp(argv[i - 1], "-o") == 0) {
+
+            headerFilename = value;
+
+        } else if (strcmp(argv[i - 1], "-b") == 0) {
+
+            binaryFilename = value;
+
+        }
+
+    }
+
+    if (i != argc - 1 || (headerFilename == NULL && binaryFilename == NULL)) {
+
+        printf("Usage: %s [-o MODEL.h] [-b MODEL.bin] MODEL.txt\n", argv[0]);
+
+        return 1;
+
+    }
+
+    FILE *input = fopen(argv[i], "r");
+
+    if (input == NULL) {
+
+        printf("Could not open %s\n", argv[i]);
+
+        return 1;
+
+    }
+
+    bool success = readModel(input);
+
+    fclose(input);
+
+    if (!success) {
+
+        printf("Could not read the model in %s\n", argv[i]);
+
+        return 1;
+
+    }
+
+    /* Report the size and work of the model */
+
+    const classifierHeader_t *header = (const classifierHeader_t*)model;
+
+    const uint8_t *position = model + sizeof(classifierHeader_t);
+
+    uint32_t multiplyAccumulates = 0;
+
+    for (uint32_t l = 0; l < header->numberOfLayers; l += 1) {
+
+        const classifierLayer_t *layer = (const classifierLayer_t*)position;
+
+        printf("Layer %u: %u x %u, input scale %g, weight scale %g\n", l, layer->numberOfInputs, layer->numberOfOutputs, layer->inputScale, layer->weightScale);
+
+        multiplyAccumulates += layer->rowLength * layer->numberOfOutputs;
+
+        position += sizeof(classifierLayer_t) + layer->numberOfOutputs * (sizeof(int32_t) + layer->rowLength);
+
+    }
+
+    printf("Model: %u bytes, %u multiply-accumulates per inference\n", modelSize, multiplyAccumulates);
+
+    if (headerFilename && !writeHeaderFile(headerFilename, argv[i])) {
+
+        printf("Could not write %s\n", headerFilename);
+
+        return 1;
+
+    }
+
+    if (binaryFilename && !writeBinaryFile(binaryFilename)) {
+
+        printf("Could not write %s\n", binaryFilename);
+
+        return 1;
+
+    }
+
+    return 0;
+
+}
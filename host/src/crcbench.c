@@ -0,0 +1,114 @@
+/****************************************************************************
+ * crcbench.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "crc.h"
+
+/* Benchmark constants */
+
+#define FIRMWARE_CRC_POLY                       0x1021
+#define AM_FIRMWARE_TOTAL_SIZE                  ((256 * 1024) - (16 * 1024))
+#define NUMBER_OF_REPEATS                       20
+
+/* Bit by bit CRC previously used by the USB firmware verification */
+
+static inline uint16_t updateCRC(uint16_t crc, uint32_t incr) {
+
+    uint16_t xor = crc >> 15;
+
+    uint16_t out = crc << 1;
+
+    if (incr) out++;
+
+    if (xor) out ^= FIRMWARE_CRC_POLY;
+
+    return out;
+
+}
+
+static uint16_t bitwiseCRC(const uint8_t *bytes, uint32_t length) {
+
+    uint16_t crc = 0;
+
+    for (uint32_t i = 0; i < length; i += 1) {
+
+        uint32_t byte = bytes[i];
+
+        for (uint32_t j = 0x80; j > 0; j >>= 1) crc = updateCRC(crc, byte & j);
+
+    }
+
+    for (uint32_t j = 0; j < 16; j += 1) crc = updateCRC(crc, 0);
+
+    return crc;
+
+}
+
+static double elapsedSeconds(struct timespec *start, struct timespec *end) {
+
+    return (double)(end->tv_sec - start->tv_sec) + 1e-9 * (double)(end->tv_nsec - start->tv_nsec);
+
+}
+
+/* Main function */
+
+int main(void) {
+
+    static uint8_t firmware[AM_FIRMWARE_TOTAL_SIZE];
+
+    srand(1);
+
+    for (uint32_t i = 0; i < AM_FIRMWARE_TOTAL_SIZE; i += 1) firmware[i] = rand();
+
+    /* Time both implementations over the firmware area */
+
+    struct timespec start, end;
+
+    volatile uint16_t bitwiseResult = 0, tableResult = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (uint32_t i = 0; i < NUMBER_OF_REPEATS; i += 1) bitwiseResult = bitwiseCRC(firmware, AM_FIRMWARE_TOTAL_SIZE);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double bitwiseTime = elapsedSeconds(&start, &end) / NUMBER_OF_REPEATS;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (uint32_t i = 0; i < NUMBER_OF_REPEATS; i += 1) tableResult = CRC_update(0, firmware, AM_FIRMWARE_TOTAL_SIZE);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double tableTime = elapsedSeconds(&start, &end) / NUMBER_OF_REPEATS;
+
+    /* Report results */
+
+    printf("Bitwise CRC: 0x%04X in %.3f ms\n", bitwiseResult, 1000.0 * bitwiseTime);
+
+    printf("Table CRC:   0x%04X in %.3f ms\n", tableResult, 1000.0 * tableTime);
+
+    printf("Speedup:     %.1fx\n", bitwiseTime / tableTime);
+
+    uint16_t checkResult = CRC_update(0, (const uint8_t*)"123456789", 9);
+
+    printf("Check value: 0x%04X\n", checkResult);
+
+    if (bitwiseResult != tableResult || checkResult != 0x31C3) {
+
+        printf("CRC mismatch\n");
+
+        return 1;
+
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,280 @@
+/****************************************************************************
+ * fftbench.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_CYCLE_COUNTER                       true
+#else
+#define HAS_CYCLE_COUNTER                       false
+#endif
+
+#include "fft.h"
+
+/* The 512 point transform is built from the same source with renamed functions */
+
+void FFT_realTransform512(int16_t *dataBuffer, float *fftBuffer);
+
+void FFT_completeSpectrum512(float *fftBuffer);
+
+/* Benchmark constants */
+
+#define MAXIMUM_FFT_LENGTH                      1024
+#define FULL_SCALE                              32767.0
+#define NUMBER_OF_TIMED_TRANSFORMS              20000
+#define NOISE_SEED                              12345
+
+/* Accuracy gate. A single precision transform should be close to the 24-bit mantissa limit. The bin errors are relative to the largest bin */
+
+#define MAXIMUM_ERROR                           1e-6
+#define MAXIMUM_RMS_ERROR                       3e-7
+#define MINIMUM_SNR                             110.0
+#define MAXIMUM_PARSEVAL_ERROR                  1e-5
+
+/* Transforms and test signals */
+
+typedef struct {
+    uint32_t length;
+    void (*transform)(int16_t*, float*);
+    void (*completeSpectrum)(float*);
+} variant_t;
+
+typedef enum {TONE, OFF_BIN_TONE, QUIET_TONE, CHIRP, NOISE, CLIPPED_TONE, NUMBER_OF_SIGNALS} signal_t;
+
+static const char *signalNames[NUMBER_OF_SIGNALS] = {"tone", "off-bin tone", "quiet tone", "chirp", "noise", "clipped tone"};
+
+static const variant_t variants[] = {
+    {1024, FFT_realTransform, FFT_completeSpectrum},
+    {512, FFT_realTransform512, FFT_completeSpectrum512}
+};
+
+#define NUMBER_OF_VARIANTS                      (sizeof(variants) / sizeof(variant_t))
+
+/* Buffers */
+
+static int16_t input[MAXIMUM_FFT_LENGTH];
+
+static float output[2 * MAXIMUM_FFT_LENGTH];
+
+static double window[MAXIMUM_FFT_LENGTH];
+
+static double reference[2 * MAXIMUM_FFT_LENGTH];
+
+/* Signal generation */
+
+static int16_t clip(double value) {
+
+    return value > FULL_SCALE ? FULL_SCALE : value < -FULL_SCALE ? -FULL_SCALE : (int16_t)lround(value);
+
+}
+
+static void generateSignal(signal_t signal, uint32_t length) {
+
+    uint32_t seed = NOISE_SEED;
+
+    for (uint32_t n = 0; n < length; n += 1) {
+
+        double t = (double)n / length;
+
+        double value = 0.0;
+
+        if (signal == TONE) value = 0.5 * FULL_SCALE * sin(2.0 * M_PI * length / 8 * t);
+
+        if (signal == OFF_BIN_TONE) value = 0.5 * FULL_SCALE * sin(2.0 * M_PI * (length / 8 + 0.37) * t + 0.3);
+
+        if (signal == QUIET_TONE) value = 0.001 * FULL_SCALE * sin(2.0 * M_PI * (length / 5 + 0.5) * t);
+
+        if (signal == CHIRP) value = 0.9 * FULL_SCALE * sin(M_PI * length / 2 * t * t);
+
+        if (signal == CLIPPED_TONE) value = 2.0 * FULL_SCALE * sin(2.0 * M_PI * (length / 16 + 0.2) * t);
+
+        if (signal == NOISE) {
+
+            seed = seed * 1664525 + 1013904223;
+
+            value = (double)(int16_t)(seed >> 16);
+
+        }
+
+        input[n] = clip(value);
+
+    }
+
+}
+
+/* The firmware applies a Hann window scaled by 2 / (N - 1) before the transform */
+
+static void calculateWindow(uint32_t length) {
+
+    for (uint32_t n = 0; n < length; n += 1) window[n] = (1.0 - cos(2.0 * M_PI * n / (length - 1))) / (length - 1);
+
+}
+
+static void referenceTransform(uint32_t length) {
+
+    for (uint32_t k = 0; k <= length / 2; k += 1) {
+
+        double real = 0.0, imaginary = 0.0;
+
+        for (uint32_t n = 0; n < length; n += 1) {
+
+            double angle = 2.0 * M_PI * (double)((uint64_t)k * n % length) / length;
+
+            double sample = input[n] * window[n];
+
+            real += sample * cos(angle);
+
+            imaginary -= sample * sin(angle);
+
+        }
+
+        reference[2 * k] = real;
+
+        reference[2 * k + 1] = imaginary;
+
+    }
+
+}
+
+/* Timing */
+
+static double elapsedNanoseconds(struct timespec *start, struct timespec *end) {
+
+    return 1e9 * (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec);
+
+}
+
+static void timeTransform(const variant_t *variant) {
+
+    generateSignal(NOISE, variant->length);
+
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+#if HAS_CYCLE_COUNTER
+    uint64_t startCycles = __rdtsc();
+#endif
+
+    for (uint32_t i = 0; i < NUMBER_OF_TIMED_TRANSFORMS; i += 1) variant->transform(input, output);
+
+#if HAS_CYCLE_COUNTER
+    uint64_t cycles = __rdtsc() - startCycles;
+#endif
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    printf("%5u  %.1f ns per transform", variant->length, elapsedNanoseconds(&start, &end) / NUMBER_OF_TIMED_TRANSFORMS);
+
+#if HAS_CYCLE_COUNTER
+    printf(", %.0f TSC cycles per transform", (double)cycles / NUMBER_OF_TIMED_TRANSFORMS);
+#endif
+
+    printf("\n");
+
+}
+
+/* Accuracy */
+
+static bool checkAccuracy(const variant_t *variant, signal_t signal) {
+
+    uint32_t length = variant->length;
+
+    generateSignal(signal, length);
+
+    referenceTransform(length);
+
+    variant->transform(input, output);
+
+    /* Compare the bins up to the Nyquist frequency */
+
+    uint32_t numberOfBins = length / 2 + 1;
+
+    double maximumError = 0.0, maximumReference = 0.0, errorEnergy = 0.0, referenceEnergy = 0.0;
+
+    for (uint32_t i = 0; i < length + 2; i += 2) {
+
+        double realError = output[i] - reference[i];
+
+        double imaginaryError = output[i + 1] - reference[i + 1];
+
+        double error = sqrt(realError * realError + imaginaryError * imaginaryError);
+
+        double magnitude = sqrt(reference[i] * reference[i] + reference[i + 1] * reference[i + 1]);
+
+        if (error > maximumError) maximumError = error;
+
+        if (magnitude > maximumReference) maximumReference = magnitude;
+
+        errorEnergy += error * error;
+
+        referenceEnergy += magnitude * magnitude;
+
+    }
+
+    double snr = 10.0 * log10(referenceEnergy / errorEnergy);
+
+    /* Both errors are relative to the largest bin so the maximum is never below the RMS */
+
+    double relativeMaximumError = maximumError / maximumReference;
+
+    double relativeRmsError = sqrt(errorEnergy / numberOfBins) / maximumReference;
+
+    /* Parseval over the complete spectrum */
+
+    variant->completeSpectrum(output);
+
+    double timeEnergy = 0.0, frequencyEnergy = 0.0;
+
+    for (uint32_t n = 0; n < length; n += 1) {
+
+        double sample = input[n] * window[n];
+
+        timeEnergy += sample * sample;
+
+        frequencyEnergy += ((double)output[2 * n] * output[2 * n] + (double)output[2 * n + 1] * output[2 * n + 1]) / length;
+
+    }
+
+    double parsevalError = fabs(frequencyEnergy - timeEnergy) / timeEnergy;
+
+    bool success = relativeMaximumError <= MAXIMUM_ERROR && relativeRmsError <= MAXIMUM_RMS_ERROR && snr >= MINIMUM_SNR && parsevalError <= MAXIMUM_PARSEVAL_ERROR;
+
+    printf("%5u  %-14s %12.3e %12.3e %9.1f %12.3e  %s\n", length, signalNames[signal], relativeMaximumError, relativeRmsError, snr, parsevalError, success ? "ok" : "FAIL");
+
+    return success;
+
+}
+
+/* Main function */
+
+int main(int argc, char **argv) {
+
+    bool success = true;
+
+    printf(" size  signal           max error    rms error   snr dB     parseval\n");
+
+    for (uint32_t i = 0; i < NUMBER_OF_VARIANTS; i += 1) {
+
+        calculateWindow(variants[i].length);
+
+        for (uint32_t signal = 0; signal < NUMBER_OF_SIGNALS; signal += 1) success &= checkAccuracy(variants + i, signal);
+
+    }
+
+    printf("\n");
+
+    for (uint32_t i = 0; i < NUMBER_OF_VARIANTS; i += 1) timeTransform(variants + i);
+
+    return success ? 0 : 1;
+
+}
@@ -0,0 +1,575 @@
+/****************************************************************************
+ * hostmoth.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <time.h>
+#include <stdio.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "config.h"
+#include "profile.h"
+#include "download.h"
+#include "audiomoth.h"
+
+/* Simulation constants */
+
+#define MICROSECONDS_IN_MILLISECOND             1000
+#define MICROSECONDS_IN_SECOND                  1000000
+
+#define HOST_REBOOT                             1
+#define HOST_FINISHED                           2
+
+#define MAXIMUM_PATH_LENGTH                     1024
+
+/* The device full scale is 2^11 times the oversample rate and the WAV full scale is 2^15 */
+
+#define WAVE_FULL_SCALE_SHIFT                   4
+
+/* Simulated memory regions */
+
+uint32_t hostBackupDomain[AM_BACKUP_DOMAIN_SIZE_IN_REGISTERS];
+
+uint8_t hostFlashUserDataPage[AM_FLASH_USER_SIZE_IN_BYTES];
+
+uint8_t hostUniqueID[AM_UNIQUE_ID_SIZE_IN_BYTES] = {0x48, 0x4F, 0x53, 0x54, 0x4D, 0x4F, 0x54, 0x48};
+
+uint32_t hostExternalSRAM[AM_EXTERNAL_SRAM_SIZE_IN_BYTES / sizeof(uint32_t)];
+
+/* Simulation state. Power down jumps back to the start of the firmware as a reset would */
+
+static jmp_buf wakeUp;
+
+static uint32_t numberOfBoots;
+
+static uint64_t currentMicroseconds;
+
+static uint64_t endMicroseconds;
+
+static uint32_t realTimeClockPeriod;
+
+static AM_highFrequencyClockDivider_t clockDivider;
+
+/* Wave file feeding the DMA transfers */
+
+static FILE *waveFile;
+
+static long waveDataOffset;
+
+static uint32_t waveSampleRate;
+
+static uint32_t waveNumberOfChannels;
+
+static uint64_t waveNumberOfSamples;
+
+static uint64_t waveStartMicroseconds;
+
+static int16_t waveSamples[2 * UINT16_MAX];
+
+/* DMA state */
+
+static int16_t *directMemoryAccessBuffers[2];
+
+static uint32_t numberOfSamplesPerTransfer;
+
+static uint32_t oversampleRate;
+
+static bool microphoneSampling;
+
+static bool nextBufferIsPrimary;
+
+static uint64_t samplePosition;
+
+static uint64_t samplesSinceStart;
+
+static uint64_t microsecondsAtStart;
+
+static uint64_t samplesProcessed;
+
+/* Output files */
+
+static char outputDirectory[MAXIMUM_PATH_LENGTH] = ".";
+
+static FILE *file;
+
+/* The cycle counter runs on host time unless it is stopped so the output can be reproduced */
+
+static bool cycleCounterStopped;
+
+/* Private functions */
+
+static void advanceTime(uint64_t microseconds) {
+
+    currentMicroseconds += microseconds;
+
+    if (currentMicroseconds >= endMicroseconds) longjmp(wakeUp, HOST_FINISHED);
+
+}
+
+static uint32_t readLittleEndian(uint8_t *bytes, uint32_t length) {
+
+    uint32_t value = 0;
+
+    for (uint32_t i = 0; i < length; i += 1) value |= (uint32_t)bytes[i] << (8 * i);
+
+    return value;
+
+}
+
+static void transferBuffer(void) {
+
+    /* Fill the next buffer with the samples which would arrive in that time */
+
+    if (samplePosition + numberOfSamplesPerTransfer > waveNumberOfSamples) longjmp(wakeUp, HOST_FINISHED);
+
+    int16_t *buffer = directMemoryAccessBuffers[nextBufferIsPrimary ? 0 : 1];
+
+    fseek(waveFile, waveDataOffset + samplePosition * waveNumberOfChannels * sizeof(int16_t), SEEK_SET);
+
+    if (fread(waveSamples, sizeof(int16_t) * waveNumberOfChannels, numberOfSamplesPerTransfer, waveFile) != numberOfSamplesPerTransfer) longjmp(wakeUp, HOST_FINISHED);
+
+    for (uint32_t i = 0; i < numberOfSamplesPerTransfer; i += 1) {
+
+        int32_t sample = (int32_t)waveSamples[i * waveNumberOfChannels] * (int32_t)oversampleRate >> WAVE_FULL_SCALE_SHIFT;
+
+        buffer[i] = sample > INT16_MAX ? INT16_MAX : sample < INT16_MIN ? INT16_MIN : sample;
+
+    }
+
+    samplePosition += numberOfSamplesPerTransfer;
+
+    samplesSinceStart += numberOfSamplesPerTransfer;
+
+    samplesProcessed += numberOfSamplesPerTransfer;
+
+    uint64_t microseconds = microsecondsAtStart + samplesSinceStart * MICROSECONDS_IN_SECOND / waveSampleRate;
+
+    advanceTime(microseconds - currentMicroseconds);
+
+    /* Call the interrupt handler as the DMA would */
+
+    int16_t *nextBuffer = NULL;
+
+    AudioMoth_handleDirectMemoryAccessInterrupt(nextBufferIsPrimary, &nextBuffer);
+
+    nextBufferIsPrimary = !nextBufferIsPrimary;
+
+}
+
+/* Host simulation functions */
+
+bool Host_openWaveFile(char *filename, uint32_t startTime) {
+
+    waveFile = fopen(filename, "rb");
+
+    if (waveFile == NULL) return false;
+
+    uint8_t header[12], chunkHeader[8], format[16];
+
+    if (fread(header, 1, sizeof(header), waveFile) != sizeof(header) || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4)) return false;
+
+    bool foundFormat = false;
+
+    while (fread(chunkHeader, 1, sizeof(chunkHeader), waveFile) == sizeof(chunkHeader)) {
+
+        uint32_t chunkSize = readLittleEndian(chunkHeader + 4, 4);
+
+        if (memcmp(chunkHeader, "fmt ", 4) == 0) {
+
+            if (chunkSize < sizeof(format) || fread(format, 1, sizeof(format), waveFile) != sizeof(format)) return false;
+
+            if (readLittleEndian(format, 2) != 1 || readLittleEndian(format + 14, 2) != 16) return false;
+
+            waveNumberOfChannels = readLittleEndian(format + 2, 2);
+
+            if (waveNumberOfChannels == 0 || waveNumberOfChannels > 2) return false;
+
+            waveSampleRate = readLittleEndian(format + 4, 4);
+
+            fseek(waveFile, chunkSize - sizeof(format), SEEK_CUR);
+
+            foundFormat = true;
+
+        } else if (memcmp(chunkHeader, "data", 4) == 0) {
+
+            if (!foundFormat) return false;
+
+            waveDataOffset = ftell(waveFile);
+
+            waveNumberOfSamples = chunkSize / sizeof(int16_t) / waveNumberOfChannels;
+
+            /* The simulation starts with the recording and ends when the samples run out */
+
+            waveStartMicroseconds = (uint64_t)startTime * MICROSECONDS_IN_SECOND;
+
+            currentMicroseconds = waveStartMicroseconds;
+
+            endMicroseconds = waveStartMicroseconds + waveNumberOfSamples * MICROSECONDS_IN_SECOND / waveSampleRate;
+
+            return true;
+
+        } else {
+
+            fseek(waveFile, chunkSize + (chunkSize & 1), SEEK_CUR);
+
+        }
+
+    }
+
+    return false;
+
+}
+
+void Host_setOutputDirectory(char *directory) {
+
+    snprintf(outputDirectory, MAXIMUM_PATH_LENGTH, "%s", directory);
+
+}
+
+void Host_stopCycleCounter(void) {
+
+    cycleCounterStopped = true;
+
+}
+
+bool Host_loadConfiguration(char *filename) {
+
+    /* Configurations are loaded into the flash user data page as they would be over USB */
+
+    FILE *configFile = fopen(filename, "rb");
+
+    if (configFile == NULL) return false;
+
+    bool success = fread(hostFlashUserDataPage, 1, sizeof(configSettings_t), configFile) == sizeof(configSettings_t);
+
+    fclose(configFile);
+
+    return success;
+
+}
+
+uint32_t Host_run(void) {
+
+    numberOfBoots = 0;
+
+    while (setjmp(wakeUp) != HOST_FINISHED) firmwareMain();
+
+    if (file) fclose(file);
+
+    file = NULL;
+
+    return numberOfBoots;
+
+}
+
+uint64_t Host_getSamplesProcessed(void) {
+
+    return samplesProcessed;
+
+}
+
+/* Initialise device */
+
+void AudioMoth_initialise(void) {
+
+    numberOfBoots += 1;
+
+    clockDivider = AM_HF_CLK_DIV1;
+
+    microphoneSampling = false;
+
+    realTimeClockPeriod = 0;
+
+}
+
+bool AudioMoth_isInitialPowerUp(void) {
+
+    return numberOfBoots == 1;
+
+}
+
+/* Clock control */
+
+void AudioMoth_setClockDivider(AM_highFrequencyClockDivider_t divider) {
+
+    clockDivider = divider;
+
+}
+
+AM_highFrequencyClockDivider_t AudioMoth_getClockDivider(void) {
+
+    return clockDivider;
+
+}
+
+/* Microphone samples */
+
+bool AudioMoth_enableMicrophone(AM_gainRange_t gainRange, AM_gainSetting_t gainSetting, uint32_t clockDivider, uint32_t acquisitionCycles, uint32_t oversampleRateSetting) {
+
+    oversampleRate = oversampleRateSetting;
+
+    return true;
+
+}
+
+void AudioMoth_disableMicrophone(void) {
+
+    microphoneSampling = false;
+
+}
+
+void AudioMoth_initialiseDirectMemoryAccess(int16_t *primaryBuffer, int16_t *secondaryBuffer, uint16_t numberOfSamples) {
+
+    directMemoryAccessBuffers[0] = primaryBuffer;
+
+    directMemoryAccessBuffers[1] = secondaryBuffer;
+
+    numberOfSamplesPerTransfer = numberOfSamples;
+
+}
+
+void AudioMoth_startMicrophoneSamples(uint32_t sampleRate) {
+
+    if (sampleRate != waveSampleRate) {
+
+        printf("The configured sample rate of %u Hz does not match the %u Hz WAV file\n", sampleRate, waveSampleRate);
+
+        longjmp(wakeUp, HOST_FINISHED);
+
+    }
+
+    samplePosition = (currentMicroseconds - waveStartMicroseconds) * waveSampleRate / MICROSECONDS_IN_SECOND;
+
+    samplesSinceStart = 0;
+
+    microsecondsAtStart = currentMicroseconds;
+
+    nextBufferIsPrimary = true;
+
+    microphoneSampling = true;
+
+}
+
+/* USB */
+
+void AudioMoth_handleUSB(void) { }
+
+/* Flash user data page */
+
+bool AudioMoth_writeToFlashUserDataPage(uint8_t *data, uint32_t length) {
+
+    if (length > AM_FLASH_USER_SIZE_IN_BYTES) return false;
+
+    memcpy(hostFlashUserDataPage, data, length);
+
+    return true;
+
+}
+
+/* Time */
+
+void AudioMoth_getTime(uint32_t *time, uint32_t *milliseconds) {
+
+    *time = currentMicroseconds / MICROSECONDS_IN_SECOND;
+
+    *milliseconds = currentMicroseconds % MICROSECONDS_IN_SECOND / MICROSECONDS_IN_MILLISECOND;
+
+}
+
+/* Real time clock */
+
+void AudioMoth_startRealTimeClock(uint32_t seconds) {
+
+    realTimeClockPeriod = seconds;
+
+}
+
+void AudioMoth_stopRealTimeClock(void) {
+
+    realTimeClockPeriod = 0;
+
+}
+
+void AudioMoth_checkAndHandleTimeOverflow(void) { }
+
+/* Switch position monitoring */
+
+AM_switchPosition_t AudioMoth_getSwitchPosition(void) {
+
+    return AM_SWITCH_DEFAULT;
+
+}
+
+/* Busy delay */
+
+void AudioMoth_delay(uint32_t milliseconds) {
+
+    advanceTime((uint64_t)milliseconds * MICROSECONDS_IN_MILLISECOND);
+
+}
+
+/* Sleep and power down. Without a wake up source the device would never wake so the simulation ends */
+
+void AudioMoth_sleep(void) {
+
+    if (!microphoneSampling) longjmp(wakeUp, HOST_FINISHED);
+
+    transferBuffer();
+
+}
+
+void AudioMoth_deepSleep(void) {
+
+    if (realTimeClockPeriod == 0) longjmp(wakeUp, HOST_FINISHED);
+
+    advanceTime((uint64_t)realTimeClockPeriod * MICROSECONDS_IN_SECOND);
+
+}
+
+void AudioMoth_powerDownAndWakeMilliseconds(uint32_t milliseconds) {
+
+    advanceTime((uint64_t)milliseconds * MICROSECONDS_IN_MILLISECOND);
+
+    longjmp(wakeUp, HOST_REBOOT);
+
+}
+
+/* LED control */
+
+void AudioMoth_setRedLED(bool state) { }
+
+void AudioMoth_setBothLED(bool state) { }
+
+void AudioMoth_setGreenLED(bool state) { }
+
+/* External SRAM is always fitted */
+
+bool AudioMoth_enableExternalSRAM(void) {
+
+    return true;
+
+}
+
+void AudioMoth_disableExternalSRAM(void) { }
+
+/* File system. Files are written to the output directory */
+
+bool AudioMoth_enableFileSystem(AM_sdCardSpeed_t speed) {
+
+    return true;
+
+}
+
+void AudioMoth_disableFileSystem(void) { }
+
+bool AudioMoth_openFile(char *filename) {
+
+    char path[2 * MAXIMUM_PATH_LENGTH];
+
+    snprintf(path, sizeof(path), "%s/%s", outputDirectory, filename);
+
+    file = fopen(path, "w+b");
+
+    return file != NULL;
+
+}
+
+bool AudioMoth_appendFile(char *filename) {
+
+    char path[2 * MAXIMUM_PATH_LENGTH];
+
+    snprintf(path, sizeof(path), "%s/%s", outputDirectory, filename);
+
+    file = fopen(path, "r+b");
+
+    if (file == NULL) file = fopen(path, "w+b");
+
+    if (file == NULL) return false;
+
+    return fseek(file, 0, SEEK_END) == 0;
+
+}
+
+bool AudioMoth_readFile(char *buffer, uint32_t bufferSize) {
+
+    return fread(buffer, 1, bufferSize, file) == bufferSize;
+
+}
+
+bool AudioMoth_seekInFile(uint32_t position) {
+
+    return fseek(file, position, SEEK_SET) == 0;
+
+}
+
+uint32_t AudioMoth_getFileSize(void) {
+
+    long position = ftell(file);
+
+    fseek(file, 0, SEEK_END);
+
+    long size = ftell(file);
+
+    fseek(file, position, SEEK_SET);
+
+    return size;
+
+}
+
+bool AudioMoth_writeToFile(void *bytes, uint16_t bytesToWrite) {
+
+    return fwrite(bytes, 1, bytesToWrite, file) == bytesToWrite;
+
+}
+
+bool AudioMoth_closeFile(void) {
+
+    bool success = fclose(file) == 0;
+
+    file = NULL;
+
+    return success;
+
+}
+
+/* Modules which need the device hardware */
+
+void Profile_start(void) { }
+
+uint32_t Profile_getCycleCount(void) {
+
+    if (cycleCounterStopped) return 0;
+
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec * 1000000000ULL + time.tv_nsec;
+
+}
+
+void Profile_reset(profileState_t *state) { }
+
+void Profile_mark(profileState_t *state, PROFILE_phase_t phase) { }
+
+void Profile_endCycle(profileState_t *state) { }
+
+bool Profile_appendRecord(profileState_t *state, uint32_t time, uint32_t processingCycles) {
+
+    return true;
+
+}
+
+void Download_initialise(uint8_t *workspace) { }
+
+void Download_loop(void) { }
+
+void Download_stop(void) { }
+
+void Download_packetReceived(uint8_t *receiveBuffer, uint8_t *transmitBuffer, uint32_t size) { }
+
+void Download_packetRequested(uint8_t *transmitBuffer, uint32_t size) { }
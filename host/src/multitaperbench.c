@@ -0,0 +1,301 @@
+/****************************************************************************
+ * multitaperbench.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_CYCLE_COUNTER                       true
+#else
+#define HAS_CYCLE_COUNTER                       false
+#endif
+
+#include "fft.h"
+#include "multitaper.h"
+
+/* Benchmark constants. The averaged estimate uses the default number of buffers and the multitaper estimate the number the firmware collects in its place */
+
+#define FFT_LENGTH                              1024
+#define NUMBER_OF_BINS                          (FFT_LENGTH / 2 + 1)
+#define SAMPLE_RATE                             32000
+#define DELAY_BEFORE_FIRST_SAMPLE               30
+
+#define AVERAGED_BUFFERS                        31
+#define MULTITAPER_BUFFERS                      ((AVERAGED_BUFFERS + MULTITAPER_NUMBER_OF_TAPERS - 1) / MULTITAPER_NUMBER_OF_TAPERS)
+#define MAXIMUM_BUFFERS                         AVERAGED_BUFFERS
+
+#define NUMBER_OF_TRIALS                        400
+#define NUMBER_OF_TIMED_ESTIMATES               50
+#define NOISE_AMPLITUDE                         1000.0
+
+/* Bins used for the variance, clear of the DC and Nyquist bins */
+
+#define FIRST_BIN                               8
+#define LAST_BIN                                (NUMBER_OF_BINS - 8)
+
+/* Leakage test tone, placed between bins */
+
+#define TONE_BIN                                100.37
+#define TONE_AMPLITUDE                          16000.0
+#define NUMBER_OF_TONE_PHASES                   16
+#define NUMBER_OF_LEAKAGE_DISTANCES             4
+
+static const uint32_t leakageDistances[NUMBER_OF_LEAKAGE_DISTANCES] = {4, 8, 16, 64};
+
+/* Gates. The multitaper estimate should keep the level of the averaged one and reach about the same degrees of freedom */
+
+#define MAXIMUM_LEVEL_DIFFERENCE                0.1
+#define MINIMUM_DEGREES_OF_FREEDOM_RATIO        0.9
+
+/* Estimators */
+
+typedef enum {HANN_SINGLE, HANN_AVERAGED, MULTITAPER_SINGLE, MULTITAPER_AVERAGED, NUMBER_OF_ESTIMATORS} estimator_t;
+
+static const char *estimatorNames[NUMBER_OF_ESTIMATORS] = {"Hann", "Hann", "Multitaper", "Multitaper"};
+
+static const uint32_t estimatorBuffers[NUMBER_OF_ESTIMATORS] = {1, AVERAGED_BUFFERS, 1, MULTITAPER_BUFFERS};
+
+/* Buffers and results */
+
+static int16_t buffers[MAXIMUM_BUFFERS][FFT_LENGTH];
+
+static float fftBuffer[2 * FFT_LENGTH];
+
+static float powerBuffer[NUMBER_OF_BINS];
+
+static double powerSum[NUMBER_OF_ESTIMATORS][NUMBER_OF_BINS];
+
+static double powerSquaredSum[NUMBER_OF_ESTIMATORS][NUMBER_OF_BINS];
+
+/* Private functions */
+
+static double gaussian(void) {
+
+    double u = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+
+    double v = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+
+}
+
+static int16_t quantise(double value) {
+
+    return (int16_t)fmax(INT16_MIN, fmin(INT16_MAX, round(value)));
+
+}
+
+static void generateNoise(uint32_t numberOfBuffers) {
+
+    for (uint32_t b = 0; b < numberOfBuffers; b += 1) {
+
+        for (uint32_t n = 0; n < FFT_LENGTH; n += 1) buffers[b][n] = quantise(NOISE_AMPLITUDE * gaussian());
+
+    }
+
+}
+
+static void generateTone(double phase) {
+
+    for (uint32_t n = 0; n < FFT_LENGTH; n += 1) buffers[0][n] = quantise(TONE_AMPLITUDE * cos(2.0 * M_PI * TONE_BIN * n / FFT_LENGTH + phase));
+
+}
+
+static void estimate(estimator_t estimator) {
+
+    /* The same sums as the firmware, normalised to the mean over the buffers */
+
+    uint32_t numberOfBuffers = estimatorBuffers[estimator];
+
+    for (uint32_t b = 0; b < numberOfBuffers; b += 1) {
+
+        if (estimator == MULTITAPER_SINGLE || estimator == MULTITAPER_AVERAGED) {
+
+            Multitaper_transform(buffers[b], fftBuffer, powerBuffer, NUMBER_OF_BINS, b == 0);
+
+        } else {
+
+            FFT_realTransform(buffers[b], fftBuffer);
+
+            for (uint32_t i = 0; i < NUMBER_OF_BINS; i += 1) {
+
+                float power = fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1];
+
+                powerBuffer[i] = b == 0 ? power : powerBuffer[i] + power;
+
+            }
+
+        }
+
+    }
+
+    for (uint32_t i = 0; i < NUMBER_OF_BINS; i += 1) powerBuffer[i] /= (float)numberOfBuffers;
+
+}
+
+static uint32_t numberOfTransforms(estimator_t estimator) {
+
+    return estimatorBuffers[estimator] * (estimator == MULTITAPER_SINGLE || estimator == MULTITAPER_AVERAGED ? MULTITAPER_NUMBER_OF_TAPERS : 1);
+
+}
+
+static double leakage(estimator_t estimator, uint32_t distance) {
+
+    /* Fraction of the tone power found further than the distance from the tone, averaged over the starting phase */
+
+    double leaked = 0.0, total = 0.0;
+
+    for (uint32_t p = 0; p < NUMBER_OF_TONE_PHASES; p += 1) {
+
+        generateTone(2.0 * M_PI * p / NUMBER_OF_TONE_PHASES);
+
+        estimate(estimator == HANN_AVERAGED ? HANN_SINGLE : estimator == MULTITAPER_AVERAGED ? MULTITAPER_SINGLE : estimator);
+
+        for (uint32_t i = 1; i < NUMBER_OF_BINS - 1; i += 1) {
+
+            total += powerBuffer[i];
+
+            if (fabs((double)i - TONE_BIN) > distance) leaked += powerBuffer[i];
+
+        }
+
+    }
+
+    return 10.0 * log10(leaked / total);
+
+}
+
+static double elapsedNanoseconds(struct timespec *start, struct timespec *end) {
+
+    return 1e9 * (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec);
+
+}
+
+/* Main function */
+
+int main(void) {
+
+    srand(1);
+
+    /* Variance of each estimator over independent trials of white noise */
+
+    for (uint32_t t = 0; t < NUMBER_OF_TRIALS; t += 1) {
+
+        generateNoise(MAXIMUM_BUFFERS);
+
+        for (uint32_t e = 0; e < NUMBER_OF_ESTIMATORS; e += 1) {
+
+            estimate(e);
+
+            for (uint32_t i = 0; i < NUMBER_OF_BINS; i += 1) {
+
+                powerSum[e][i] += powerBuffer[i];
+
+                powerSquaredSum[e][i] += (double)powerBuffer[i] * (double)powerBuffer[i];
+
+            }
+
+        }
+
+    }
+
+    double meanLevel[NUMBER_OF_ESTIMATORS], degreesOfFreedom[NUMBER_OF_ESTIMATORS];
+
+    for (uint32_t e = 0; e < NUMBER_OF_ESTIMATORS; e += 1) {
+
+        /* A chi-squared estimate with v degrees of freedom has a variance of 2 / v times its mean squared */
+
+        double meanSum = 0.0, normalisedVarianceSum = 0.0;
+
+        for (uint32_t i = FIRST_BIN; i < LAST_BIN; i += 1) {
+
+            double mean = powerSum[e][i] / NUMBER_OF_TRIALS;
+
+            double variance = powerSquaredSum[e][i] / NUMBER_OF_TRIALS - mean * mean;
+
+            meanSum += mean;
+
+            normalisedVarianceSum += variance / mean / mean;
+
+        }
+
+        meanLevel[e] = 10.0 * log10(meanSum / (LAST_BIN - FIRST_BIN));
+
+        degreesOfFreedom[e] = 2.0 * (LAST_BIN - FIRST_BIN) / normalisedVarianceSum;
+
+    }
+
+    /* Timing on the host */
+
+    double nanoseconds[NUMBER_OF_ESTIMATORS], cycles[NUMBER_OF_ESTIMATORS];
+
+    for (uint32_t e = 0; e < NUMBER_OF_ESTIMATORS; e += 1) {
+
+        struct timespec start, end;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+#if HAS_CYCLE_COUNTER
+        uint64_t startCycles = __rdtsc();
+#endif
+
+        for (uint32_t i = 0; i < NUMBER_OF_TIMED_ESTIMATES; i += 1) estimate(e);
+
+#if HAS_CYCLE_COUNTER
+        cycles[e] = (double)(__rdtsc() - startCycles) / NUMBER_OF_TIMED_ESTIMATES;
+#else
+        cycles[e] = 0.0;
+#endif
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        nanoseconds[e] = elapsedNanoseconds(&start, &end) / NUMBER_OF_TIMED_ESTIMATES;
+
+    }
+
+    /* Results. The microphone is on for the settle delay and the buffers */
+
+    printf("Estimator          Buffers  FFTs  Mic on (ms)  Host (us)  TSC cycles  Level (dB)  DOF     Leakage beyond");
+
+    for (uint32_t d = 0; d < NUMBER_OF_LEAKAGE_DISTANCES; d += 1) printf(" %u", leakageDistances[d]);
+
+    printf(" bins (dB)\n");
+
+    for (uint32_t e = 0; e < NUMBER_OF_ESTIMATORS; e += 1) {
+
+        double microphoneOn = DELAY_BEFORE_FIRST_SAMPLE + 1000.0 * estimatorBuffers[e] * FFT_LENGTH / SAMPLE_RATE;
+
+        printf("%-18s %7u  %4u  %11.0f  %9.1f  %10.0f  %10.2f  %6.1f ", estimatorNames[e], estimatorBuffers[e], numberOfTransforms(e), microphoneOn, nanoseconds[e] / 1000.0, cycles[e], meanLevel[e], degreesOfFreedom[e]);
+
+        for (uint32_t d = 0; d < NUMBER_OF_LEAKAGE_DISTANCES; d += 1) printf(" %7.1f", leakage(e, leakageDistances[d]));
+
+        printf("\n");
+
+    }
+
+    /* The gates compare the multitaper estimate with the averaging it replaces */
+
+    double levelDifference = fabs(meanLevel[MULTITAPER_AVERAGED] - meanLevel[HANN_AVERAGED]);
+
+    double degreesOfFreedomRatio = degreesOfFreedom[MULTITAPER_AVERAGED] / degreesOfFreedom[HANN_AVERAGED];
+
+    bool success = levelDifference <= MAXIMUM_LEVEL_DIFFERENCE && degreesOfFreedomRatio >= MINIMUM_DEGREES_OF_FREEDOM_RATIO;
+
+    printf("Level difference:  %.3f dB\n", levelDifference);
+
+    printf("DOF ratio:         %.2f  %s\n", degreesOfFreedomRatio, success ? "ok" : "FAIL");
+
+    printf("Mic on time:       %.0f%% of the averaged estimate\n", 100.0 * (DELAY_BEFORE_FIRST_SAMPLE + 1000.0 * MULTITAPER_BUFFERS * FFT_LENGTH / SAMPLE_RATE) / (DELAY_BEFORE_FIRST_SAMPLE + 1000.0 * AVERAGED_BUFFERS * FFT_LENGTH / SAMPLE_RATE));
+
+    return success ? 0 : 1;
+
+}
@@ -0,0 +1,134 @@
+/****************************************************************************
+ * peakstest.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "peaks.h"
+
+/* Test constants. The spectrum matches a 1024 point transform at 32 kHz */
+
+#define NUMBER_OF_BINS                          513
+#define BIN_WIDTH                               31.25f
+
+#define NOISE_LEVEL                             -90.0
+#define NOISE_RIPPLE                            1.0
+
+/* Hann window leakage of a tone centred on a bin */
+
+#define TONE_NEIGHBOUR_RATIO                    0.25
+
+/* Allowed errors in the estimated peaks */
+
+#define MAXIMUM_FREQUENCY_ERROR                 0.5f
+#define MAXIMUM_LEVEL_ERROR                     0.5f
+
+/* Test cases. Tones are listed in order of decreasing level, as the peaks are returned */
+
+typedef struct {
+    const char *name;
+    uint32_t numberOfTones;
+    uint32_t toneBins[2];
+    float toneLevels[2];
+} testCase_t;
+
+#define NUMBER_OF_TEST_CASES                    4
+
+static const testCase_t testCases[NUMBER_OF_TEST_CASES] = {
+    {"Noise only", 0, {0, 0}, {0.0f, 0.0f}},
+    {"0 dB tone", 1, {100, 0}, {0.0f, 0.0f}},
+    {"0 dB tone near the top", 1, {500, 0}, {0.0f, 0.0f}},
+    {"0 dB and -60 dB tones", 2, {100, 300}, {0.0f, -60.0f}}
+};
+
+/* Spectrum */
+
+static float powerBuffer[NUMBER_OF_BINS];
+
+/* Private functions */
+
+static double uniform(void) {
+
+    return (double)rand() / (double)RAND_MAX;
+
+}
+
+static void generateSpectrum(const testCase_t *testCase) {
+
+    /* Noise bins vary by up to the ripple so the floor is full of small local maxima */
+
+    for (uint32_t i = 0; i < NUMBER_OF_BINS; i += 1) powerBuffer[i] = (float)pow(10.0, (NOISE_LEVEL + NOISE_RIPPLE * uniform()) / 10.0);
+
+    for (uint32_t t = 0; t < testCase->numberOfTones; t += 1) {
+
+        float power = powf(10.0f, testCase->toneLevels[t] / 10.0f);
+
+        uint32_t bin = testCase->toneBins[t];
+
+        powerBuffer[bin] += power;
+
+        powerBuffer[bin - 1] += power * TONE_NEIGHBOUR_RATIO;
+
+        powerBuffer[bin + 1] += power * TONE_NEIGHBOUR_RATIO;
+
+    }
+
+}
+
+static bool checkPeaks(const testCase_t *testCase, peaks_t *peaks) {
+
+    if (peaks->numberOfPeaks != testCase->numberOfTones) return false;
+
+    for (uint32_t p = 0; p < peaks->numberOfPeaks; p += 1) {
+
+        float frequency = (float)testCase->toneBins[p] * BIN_WIDTH;
+
+        if (fabsf(peaks->peaks[p].frequency - frequency) > MAXIMUM_FREQUENCY_ERROR * BIN_WIDTH) return false;
+
+        if (fabsf(peaks->peaks[p].level - testCase->toneLevels[p]) > MAXIMUM_LEVEL_ERROR) return false;
+
+    }
+
+    return true;
+
+}
+
+/* Main function */
+
+int main(void) {
+
+    srand(1);
+
+    bool success = true;
+
+    printf("Test case                 Peaks  Expected  Levels (dB)\n");
+
+    for (uint32_t c = 0; c < NUMBER_OF_TEST_CASES; c += 1) {
+
+        peaks_t peaks;
+
+        generateSpectrum(&testCases[c]);
+
+        Peaks_find(powerBuffer, NUMBER_OF_BINS, BIN_WIDTH, &peaks);
+
+        bool passed = checkPeaks(&testCases[c], &peaks);
+
+        printf("%-25s %5u  %8u ", testCases[c].name, peaks.numberOfPeaks, testCases[c].numberOfTones);
+
+        for (uint32_t p = 0; p < peaks.numberOfPeaks; p += 1) printf(" %.1f", peaks.peaks[p].level);
+
+        printf("  %s\n", passed ? "ok" : "FAIL");
+
+        success &= passed;
+
+    }
+
+    return success ? 0 : 1;
+
+}
@@ -0,0 +1,296 @@
+/****************************************************************************
+ * swotrace.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "trace.h"
+
+/* Decoder constants */
+
+#define DEFAULT_TIMESTAMP_FREQUENCY             14000000
+#define MAXIMUM_PENDING_EVENTS                  256
+#define NUMBER_OF_BUCKETS                       24
+#define MAXIMUM_BAR_LENGTH                      50
+#define MICROSECONDS_IN_SECOND                  1000000.0
+
+/* ITM packet headers */
+
+#define ITM_SYNC_HEADER                         0x00
+#define ITM_SYNC_END_HEADER                     0x80
+#define ITM_OVERFLOW_HEADER                     0x70
+#define ITM_GLOBAL_TIMESTAMP_1_HEADER           0x94
+#define ITM_GLOBAL_TIMESTAMP_2_HEADER           0xB4
+#define ITM_CONTINUATION_BIT                    0x80
+#define ITM_HARDWARE_SOURCE_BIT                 0x04
+
+/* Events are held until the timestamp which follows them arrives */
+
+typedef struct {
+    uint32_t event;
+    uint32_t payload;
+} event_t;
+
+typedef struct {
+    uint32_t count;
+    double minimum;
+    double maximum;
+    double total;
+    uint32_t buckets[NUMBER_OF_BUCKETS];
+} histogram_t;
+
+static const char *eventNames[TRACE_NUMBER_OF_EVENTS] = {"print", "dma", "fft start", "fft end", "power start", "power end", "disk write start", "disk write end"};
+
+static const char *histogramNames[TRACE_NUMBER_OF_EVENTS] = {NULL, "dma interval", "fft", NULL, "power", NULL, "disk write", NULL};
+
+static event_t pendingEvents[MAXIMUM_PENDING_EVENTS];
+
+static uint32_t numberOfPendingEvents;
+
+static histogram_t histograms[TRACE_NUMBER_OF_EVENTS];
+
+static double previousTimes[TRACE_NUMBER_OF_EVENTS];
+
+static bool previousTimeValid[TRACE_NUMBER_OF_EVENTS];
+
+static bool showTimeline;
+
+static uint32_t numberOfOverflows;
+
+static uint32_t numberOfEvents;
+
+/* Histogram functions */
+
+static void addToHistogram(histogram_t *histogram, double microseconds) {
+
+    if (histogram->count == 0 || microseconds < histogram->minimum) histogram->minimum = microseconds;
+
+    if (histogram->count == 0 || microseconds > histogram->maximum) histogram->maximum = microseconds;
+
+    histogram->count += 1;
+
+    histogram->total += microseconds;
+
+    /* Bucket n holds durations from 2^(n-1) to 2^n microseconds */
+
+    uint32_t bucket = 0;
+
+    while (bucket < NUMBER_OF_BUCKETS - 1 && microseconds >= (double)(1 << bucket)) bucket += 1;
+
+    histogram->buckets[bucket] += 1;
+
+}
+
+static void printHistogram(const char *name, histogram_t *histogram) {
+
+    printf("%s: %u samples, min %.1f us, mean %.1f us, max %.1f us\n", name, histogram->count, histogram->minimum, histogram->total / histogram->count, histogram->maximum);
+
+    uint32_t largestBucket = 0;
+
+    for (uint32_t i = 0; i < NUMBER_OF_BUCKETS; i += 1) {
+
+        if (histogram->buckets[i] > largestBucket) largestBucket = histogram->buckets[i];
+
+    }
+
+    for (uint32_t i = 0; i < NUMBER_OF_BUCKETS; i += 1) {
+
+        if (histogram->buckets[i] == 0) continue;
+
+        uint32_t barLength = (uint64_t)histogram->buckets[i] * MAXIMUM_BAR_LENGTH / largestBucket;
+
+        printf("  < %8u us %8u ", 1 << i, histogram->buckets[i]);
+
+        for (uint32_t j = 0; j < barLength; j += 1) putchar('#');
+
+        putchar('\n');
+
+    }
+
+}
+
+/* Event handling */
+
+static void handleEvent(uint32_t event, uint32_t payload, double microseconds) {
+
+    numberOfEvents += 1;
+
+    if (showTimeline) printf("%14.3f us  %-16s %u\n", microseconds, eventNames[event], payload);
+
+    /* DMA transfers are timed from the previous transfer and end events from their start event */
+
+    if (event == TRACE_EVENT_DMA_TRANSFER && previousTimeValid[event]) {
+
+        addToHistogram(histograms + event, microseconds - previousTimes[event]);
+
+    } else if (event > TRACE_EVENT_DMA_TRANSFER && !TRACE_IS_START_EVENT(event) && previousTimeValid[event - 1]) {
+
+        addToHistogram(histograms + event - 1, microseconds - previousTimes[event - 1]);
+
+        previousTimeValid[event - 1] = false;
+
+        return;
+
+    }
+
+    previousTimes[event] = microseconds;
+
+    previousTimeValid[event] = true;
+
+}
+
+static void flushPendingEvents(double microseconds) {
+
+    for (uint32_t i = 0; i < numberOfPendingEvents; i += 1) handleEvent(pendingEvents[i].event, pendingEvents[i].payload, microseconds);
+
+    numberOfPendingEvents = 0;
+
+}
+
+/* Packet decoding */
+
+static uint32_t readContinuation(FILE *input, uint8_t header) {
+
+    /* Payload bytes carry seven bits each and the top bit marks another byte */
+
+    uint32_t value = 0, shift = 0;
+
+    int byte = header;
+
+    while ((byte & ITM_CONTINUATION_BIT) && (byte = fgetc(input)) != EOF) {
+
+        if (shift < 32) value |= (uint32_t)(byte & 0x7F) << shift;
+
+        shift += 7;
+
+    }
+
+    return value;
+
+}
+
+static void decodeStream(FILE *input, double frequency) {
+
+    uint64_t timestamp = 0;
+
+    int header;
+
+    while ((header = fgetc(input)) != EOF) {
+
+        if (header == ITM_SYNC_HEADER) continue;
+
+        if (header == ITM_OVERFLOW_HEADER) {
+
+            numberOfOverflows += 1;
+
+            continue;
+
+        }
+
+        if (header == ITM_GLOBAL_TIMESTAMP_1_HEADER || header == ITM_GLOBAL_TIMESTAMP_2_HEADER) {
+
+            readContinuation(input, header);
+
+            continue;
+
+        }
+
+        if ((header & 0xCF) == 0xC0 || ((header & 0x8F) == 0 && header != ITM_OVERFLOW_HEADER)) {
+
+            /* Local timestamps hold the time since the previous timestamp */
+
+            timestamp += header & ITM_CONTINUATION_BIT ? readContinuation(input, header) : (header >> 4) & 0x07;
+
+            flushPendingEvents(MICROSECONDS_IN_SECOND * timestamp / frequency);
+
+            continue;
+
+        }
+
+        if (header == ITM_SYNC_END_HEADER) continue;
+
+        uint32_t size = header & 0x03;
+
+        if (size == 0) {
+
+            /* Extension packets */
+
+            readContinuation(input, header);
+
+            continue;
+
+        }
+
+        /* Source packets hold one, two or four bytes */
+
+        uint8_t payload[4] = {0};
+
+        uint32_t bytes = size == 3 ? 4 : size;
+
+        if (fread(payload, 1, bytes, input) != bytes) break;
+
+        uint32_t port = header >> 3;
+
+        if ((header & ITM_HARDWARE_SOURCE_BIT) || port == 0 || port >= TRACE_NUMBER_OF_EVENTS || bytes != 4) continue;
+
+        if (numberOfPendingEvents == MAXIMUM_PENDING_EVENTS) flushPendingEvents(MICROSECONDS_IN_SECOND * timestamp / frequency);
+
+        pendingEvents[numberOfPendingEvents].event = port;
+
+        pendingEvents[numberOfPendingEvents].payload = payload[0] | payload[1] << 8 | payload[2] << 16 | (uint32_t)payload[3] << 24;
+
+        numberOfPendingEvents += 1;
+
+    }
+
+    flushPendingEvents(MICROSECONDS_IN_SECOND * timestamp / frequency);
+
+}
+
+/* Main function */
+
+int main(int argc, char **argv) {
+
+    if (argc < 3 || (strcmp(argv[1], "timeline") != 0 && strcmp(argv[1], "histogram") != 0)) {
+
+        printf("Usage: %s timeline | histogram FILE [TIMESTAMP_FREQUENCY]\n", argv[0]);
+
+        return 1;
+
+    }
+
+    FILE *input = strcmp(argv[2], "-") == 0 ? stdin : fopen(argv[2], "rb");
+
+    if (input == NULL) {
+
+        printf("Could not open %s\n", argv[2]);
+
+        return 1;
+
+    }
+
+    double frequency = argc > 3 ? atof(argv[3]) : DEFAULT_TIMESTAMP_FREQUENCY;
+
+    showTimeline = argv[1][0] == 't';
+
+    decodeStream(input, frequency);
+
+    if (input != stdin) fclose(input);
+
+    printf("%u events, %u overflows\n", numberOfEvents, numberOfOverflows);
+
+    for (uint32_t i = 0; i < TRACE_NUMBER_OF_EVENTS; i += 1) {
+
+        if (histogramNames[i] && histograms[i].count > 0) printHistogram(histogramNames[i], histograms + i);
+
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,299 @@
+/****************************************************************************
+ * usbdownload.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <time.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "crc.h"
+#include "download.h"
+
+/* USB message types */
+
+#define AM_USB_MSG_TYPE_GET_APP_PACKET          0x05
+#define AM_USB_MSG_TYPE_SET_APP_PACKET          0x06
+
+/* Client constants */
+
+#define MAXIMUM_BUSY_POLLS                      100000
+#define MAXIMUM_RETRIES                         100
+
+/* Device handle. This is a Linux hidraw node such as /dev/hidraw0 */
+
+static int device;
+
+/* Send one packet and read the reply. The report ID in front of the packet is always zero */
+
+static bool exchangePacket(uint8_t *packet, uint8_t *reply) {
+
+    uint8_t report[DOWNLOAD_PACKET_SIZE + 1];
+
+    report[0] = 0;
+
+    memcpy(report + 1, packet, DOWNLOAD_PACKET_SIZE);
+
+    if (write(device, report, sizeof(report)) != sizeof(report)) return false;
+
+    if (read(device, reply, DOWNLOAD_PACKET_SIZE) != DOWNLOAD_PACKET_SIZE) return false;
+
+    return reply[0] == packet[0];
+
+}
+
+static bool sendMessage(uint8_t message, uint32_t argument, char *filename) {
+
+    uint8_t packet[DOWNLOAD_PACKET_SIZE] = {AM_USB_MSG_TYPE_SET_APP_PACKET, message};
+
+    uint8_t reply[DOWNLOAD_PACKET_SIZE];
+
+    if (filename) {
+
+        strncpy((char*)packet + 2, filename, DOWNLOAD_MAXIMUM_FILENAME_LENGTH - 1);
+
+    } else {
+
+        memcpy(packet + 2, &argument, sizeof(uint32_t));
+
+    }
+
+    return exchangePacket(packet, reply) && reply[1] == message && reply[2];
+
+}
+
+static bool requestPacket(uint8_t *reply) {
+
+    uint8_t packet[DOWNLOAD_PACKET_SIZE] = {AM_USB_MSG_TYPE_GET_APP_PACKET};
+
+    return exchangePacket(packet, reply);
+
+}
+
+/* Poll until the device replies to a message */
+
+static bool waitForReply(uint8_t message, uint8_t *reply) {
+
+    for (uint32_t i = 0; i < MAXIMUM_BUSY_POLLS; i += 1) {
+
+        if (!requestPacket(reply)) return false;
+
+        if (reply[1] == DOWNLOAD_STATUS_BUSY || reply[2] != message) continue;
+
+        return reply[1] == DOWNLOAD_STATUS_OK;
+
+    }
+
+    return false;
+
+}
+
+static bool listFile(uint32_t index, char *filename, uint32_t *size) {
+
+    uint8_t reply[DOWNLOAD_PACKET_SIZE];
+
+    if (!sendMessage(DOWNLOAD_MESSAGE_LIST, index, NULL)) return false;
+
+    if (!waitForReply(DOWNLOAD_MESSAGE_LIST, reply)) return false;
+
+    memcpy(size, reply + 4, sizeof(uint32_t));
+
+    memcpy(filename, reply + DOWNLOAD_FILENAME_OFFSET, DOWNLOAD_MAXIMUM_FILENAME_LENGTH);
+
+    filename[DOWNLOAD_MAXIMUM_FILENAME_LENGTH - 1] = 0;
+
+    return true;
+
+}
+
+/* Download a file. Out of sequence or corrupt chunks cause the device to seek back to the first missing chunk */
+
+static bool downloadFile(char *filename, FILE *output, uint32_t *bytesReceived, uint32_t *retries) {
+
+    uint8_t reply[DOWNLOAD_PACKET_SIZE];
+
+    *bytesReceived = 0;
+
+    *retries = 0;
+
+    if (!sendMessage(DOWNLOAD_MESSAGE_OPEN, 0, filename)) return false;
+
+    if (!waitForReply(DOWNLOAD_MESSAGE_OPEN, reply)) return false;
+
+    uint32_t size;
+
+    memcpy(&size, reply + 4, sizeof(uint32_t));
+
+    uint32_t expectedSequence = 0;
+
+    uint32_t busyPolls = 0;
+
+    while (true) {
+
+        if (!requestPacket(reply)) return false;
+
+        if (reply[1] == DOWNLOAD_STATUS_ERROR) return false;
+
+        if (reply[1] == DOWNLOAD_STATUS_BUSY || reply[2] != DOWNLOAD_MESSAGE_DATA) {
+
+            if (++busyPolls > MAXIMUM_BUSY_POLLS) return false;
+
+            continue;
+
+        }
+
+        busyPolls = 0;
+
+        uint32_t sequence, length = reply[3];
+
+        uint16_t crc;
+
+        memcpy(&sequence, reply + 4, sizeof(uint32_t));
+
+        memcpy(&crc, reply + 8, sizeof(uint16_t));
+
+        uint16_t calculatedCRC = CRC_update(0, reply + 2, 6);
+
+        calculatedCRC = length <= DOWNLOAD_CHUNK_DATA_SIZE ? CRC_update(calculatedCRC, reply + DOWNLOAD_CHUNK_HEADER_SIZE, length) : ~crc;
+
+        if (sequence != expectedSequence || calculatedCRC != crc) {
+
+            /* The device replies busy until it has restarted from the requested chunk */
+
+            if (++*retries > MAXIMUM_RETRIES) return false;
+
+            if (!sendMessage(DOWNLOAD_MESSAGE_SEEK, expectedSequence, NULL)) return false;
+
+            continue;
+
+        }
+
+        if (length == 0) break;
+
+        if (output && fwrite(reply + DOWNLOAD_CHUNK_HEADER_SIZE, 1, length, output) != length) return false;
+
+        *bytesReceived += length;
+
+        expectedSequence += 1;
+
+    }
+
+    return *bytesReceived == size;
+
+}
+
+static double elapsedSeconds(struct timespec *start, struct timespec *end) {
+
+    return (double)(end->tv_sec - start->tv_sec) + 1e-9 * (double)(end->tv_nsec - start->tv_nsec);
+
+}
+
+static bool transferFile(char *filename, bool saveFile) {
+
+    FILE *output = NULL;
+
+    if (saveFile) {
+
+        output = fopen(filename, "wb");
+
+        if (output == NULL) {
+
+            printf("Could not create %s\n", filename);
+
+            return false;
+
+        }
+
+    }
+
+    struct timespec start, end;
+
+    uint32_t bytesReceived, retries;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    bool success = downloadFile(filename, output, &bytesReceived, &retries);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (output) fclose(output);
+
+    double seconds = elapsedSeconds(&start, &end);
+
+    printf("%s: %u bytes in %.2f s (%.0f bytes/s, %u retries)%s\n", filename, bytesReceived, seconds, seconds > 0.0 ? bytesReceived / seconds : 0.0, retries, success ? "" : " FAILED");
+
+    return success;
+
+}
+
+/* Main function */
+
+int main(int argc, char **argv) {
+
+    if (argc < 3) {
+
+        printf("Usage: %s DEVICE list | get FILE | all | benchmark FILE\n", argv[0]);
+
+        return 1;
+
+    }
+
+    device = open(argv[1], O_RDWR);
+
+    if (device < 0) {
+
+        printf("Could not open %s\n", argv[1]);
+
+        return 1;
+
+    }
+
+    char *command = argv[2];
+
+    char filename[DOWNLOAD_MAXIMUM_FILENAME_LENGTH];
+
+    uint32_t size;
+
+    bool success = true;
+
+    if (strcmp(command, "list") == 0 || strcmp(command, "all") == 0) {
+
+        for (uint32_t index = 0; success && listFile(index, filename, &size); index += 1) {
+
+            if (command[0] == 'l') {
+
+                printf("%s %u\n", filename, size);
+
+            } else {
+
+                success = transferFile(filename, true);
+
+            }
+
+        }
+
+    } else if ((strcmp(command, "get") == 0 || strcmp(command, "benchmark") == 0) && argc > 3) {
+
+        success = transferFile(argv[3], command[0] == 'g');
+
+    } else {
+
+        printf("Unknown command %s\n", command);
+
+        success = false;
+
+    }
+
+    sendMessage(DOWNLOAD_MESSAGE_CLOSE, 0, NULL);
+
+    close(device);
+
+    return success ? 0 : 1;
+
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+ * wavpipeline.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "audiomoth.h"
+
+/* AudioMoth WAV files are named by their start time */
+
+#define FILENAME_TIME_FORMAT                    "%4d%2d%2d_%2d%2d%2d"
+#define FILENAME_TIME_FIELDS                    6
+#define YEAR_OFFSET                             1900
+#define MONTH_OFFSET                            1
+
+/* Private functions */
+
+static bool timeFromFilename(char *filename, uint32_t *startTime) {
+
+    char *basename = strrchr(filename, '/');
+
+    basename = basename ? basename + 1 : filename;
+
+    struct tm time = {0};
+
+    if (sscanf(basename, FILENAME_TIME_FORMAT, &time.tm_year, &time.tm_mon, &time.tm_mday, &time.tm_hour, &time.tm_min, &time.tm_sec) != FILENAME_TIME_FIELDS) return false;
+
+    time.tm_year -= YEAR_OFFSET;
+
+    time.tm_mon -= MONTH_OFFSET;
+
+    *startTime = timegm(&time);
+
+    return true;
+
+}
+
+static double elapsedSeconds(struct timespec *start, struct timespec *end) {
+
+    return (double)(end->tv_sec - start->tv_sec) + 1e-9 * (double)(end->tv_nsec - start->tv_nsec);
+
+}
+
+/* Main function */
+
+int main(int argc, char **argv) {
+
+    char *directory = ".", *configuration = NULL, *filename = NULL;
+
+    bool timeSet = false, cycleCounterStopped = false;
+
+    uint32_t startTime = 0;
+
+    for (int i = 1; i < argc; i += 1) {
+
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+
+            directory = argv[++i];
+
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+
+            configuration = argv[++i];
+
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+
+            startTime = strtoul(argv[++i], NULL, 10);
+
+            timeSet = true;
+
+        } else if (strcmp(argv[i], "-r") == 0) {
+
+            cycleCounterStopped = true;
+
+        } else {
+
+            filename = argv[i];
+
+        }
+
+    }
+
+    if (filename == NULL) {
+
+        printf("Usage: %s [-o DIRECTORY] [-c CONFIG] [-t START_TIME] [-r] FILE.WAV\n", argv[0]);
+
+        return 1;
+
+    }
+
+    if (!timeSet && !timeFromFilename(filename, &startTime)) {
+
+        printf("Could not read the start time from %s so use -t\n", filename);
+
+        return 1;
+
+    }
+
+    if (configuration && !Host_loadConfiguration(configuration)) {
+
+        printf("Could not read the configuration from %s\n", configuration);
+
+        return 1;
+
+    }
+
+    if (!Host_openWaveFile(filename, startTime)) {
+
+        printf("Could not read %s as a 16-bit PCM WAV file\n", filename);
+
+        return 1;
+
+    }
+
+    Host_setOutputDirectory(directory);
+
+    if (cycleCounterStopped) Host_stopCycleCounter();
+
+    /* Run the firmware until the samples run out */
+
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    uint32_t numberOfBoots = Host_run();
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = elapsedSeconds(&start, &end);
+
+    uint64_t samplesProcessed = Host_getSamplesProcessed();
+
+    printf("%s: %u wakes, %lu samples in %.3f s (%.0f samples/s)\n", filename, numberOfBoots, (unsigned long)samplesProcessed, seconds, seconds > 0.0 ? samplesProcessed / seconds : 0.0);
+
+    return 0;
+
+}
@@ -72,6 +72,10 @@ extern void AudioMoth_usbFirmwareDescriptionRequested(uint8_t **firmwareDescript
 extern void AudioMoth_usbApplicationPacketRequested(uint32_t messageType, uint8_t *transmitBuffer, uint32_t size);
 extern void AudioMoth_usbApplicationPacketReceived(uint32_t messageType, uint8_t *receiveBuffer, uint8_t *transmitBuffer, uint32_t size);
 
+/* USB loop handler */
+
+extern void AudioMoth_usbApplicationLoop(void);
+
 /* Initialise device */
 
 void AudioMoth_initialise(void);
@@ -206,6 +210,7 @@ bool AudioMoth_enableFileSystem(AM_sdCardSpeed_t speed);
 void AudioMoth_disableFileSystem(void);
 
 bool AudioMoth_doesFileExist(char *filename);
+bool AudioMoth_findFile(char *extension, uint32_t index, char *filename, uint32_t maximumLength, uint32_t *fileSize);
 
 bool AudioMoth_openFile(char *filename);
 bool AudioMoth_openFileToRead(char *filename);
@@ -213,6 +218,7 @@ bool AudioMoth_readFile(char *buffer, uint32_t bufferSize);
 bool AudioMoth_appendFile(char *filename);
 
 bool AudioMoth_seekInFile(uint32_t position);
+uint32_t AudioMoth_getFileSize(void);
 bool AudioMoth_writeToFile(void *bytes, uint16_t bytesToWrite);
 
 bool AudioMoth_renameFile(char *originalFilename, char *newFilename);
@@ -0,0 +1,73 @@
+/****************************************************************************
+ * classifier.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __CLASSIFIER_H
+#define __CLASSIFIER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Classifier constants */
+
+#define CLASSIFIER_MAGIC                        "CLSF"
+#define CLASSIFIER_VERSION                      1
+
+#define CLASSIFIER_MAXIMUM_NUMBER_OF_LAYERS     4
+#define CLASSIFIER_MAXIMUM_WIDTH                64
+
+#define CLASSIFIER_ACTIVATION_NONE              0
+#define CLASSIFIER_ACTIVATION_RELU              1
+#define CLASSIFIER_ACTIVATION_LOGISTIC          2
+
+#define CLASSIFIER_THRESHOLD                    0.5f
+
+/* Model layout. The header is followed by each layer header, its int32 biases and its int8 weights. Weight rows are padded with zeros to a multiple of four so every row starts on a word. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t numberOfLayers;
+    uint16_t numberOfInputs;
+    uint16_t reserved;
+    uint32_t size;
+    float inputOffset;
+} classifierHeader_t;
+
+typedef struct {
+    uint16_t numberOfInputs;
+    uint16_t numberOfOutputs;
+    uint16_t rowLength;
+    uint8_t activation;
+    uint8_t reserved;
+    float inputScale;
+    float weightScale;
+} classifierLayer_t;
+
+/* Summary of the classifier output over the frames of one record */
+
+typedef struct {
+    float maximumProbability;
+    float meanProbability;
+    uint32_t cyclesPerInference;
+    uint16_t positiveFrames;
+    uint16_t numberOfFrames;
+} classification_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+bool Classifier_initialise(const void *model, uint32_t numberOfInputs);
+
+float Classifier_predict(float *inputs);
+
+bool Classifier_update(float *inputs);
+
+void Classifier_calculate(classification_t *classification, uint32_t inferenceCycles);
+
+#endif /* __CLASSIFIER_H */
@@ -0,0 +1,22 @@
+/****************************************************************************
+ * classifier_model.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <stdint.h>
+
+/* Classifier model converted by host/bin/classifierconvert from example.txt */
+
+static const uint32_t classifierModel[59] = {
+    0x46534C43, 0x00020001, 0x00000028, 0x000000EC, 0xC2700000, 0x00040028,
+    0x00010028, 0x3F050A14, 0x3A810204, 0xFFFFB3A2, 0xFFFFB3A2, 0xFFFFB3A2,
+    0xFFFFB3A2, 0x9A9A9A9A, 0x9A9A9A9A, 0x00009A9A, 0x00000000, 0x00000000,
+    0x66666666, 0x66666666, 0x00006666, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x66666666, 0x66666666,
+    0x00006666, 0x81818181, 0x81818181, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x66666666, 0x66666666, 0x00006666, 0x00000000,
+    0x00000000, 0x9A9A9A9A, 0x9A9A9A9A, 0x66669A9A, 0x66666666, 0x66666666,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00010004,
+    0x00020004, 0x3F499326, 0x3B1ACF38, 0xFFFFF799, 0x2A557F7F
+};
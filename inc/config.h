@@ -0,0 +1,88 @@
+/****************************************************************************
+ * config.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __CONFIG_H
+#define __CONFIG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Configuration constants */
+
+#define CONFIG_VERSION                          4
+
+#define CONFIG_MESSAGE_SET                      0x08
+#define CONFIG_MESSAGE_GET                      0x09
+
+#define CONFIG_PACKET_OFFSET                    4
+#define CONFIG_MAXIMUM_PACKET_LENGTH            60
+
+/* Schedule constants */
+
+#define CONFIG_MAXIMUM_SCHEDULE_WINDOWS         4
+
+/* Schedule window modes. Each bit lets the wakes in the window write a record section, when the firmware is built to record it */
+
+#define CONFIG_SCHEDULE_MODE_SPECTRUM           0x01
+#define CONFIG_SCHEDULE_MODE_INDICES            0x02
+#define CONFIG_SCHEDULE_MODE_STATISTICS         0x04
+#define CONFIG_SCHEDULE_MODE_PEAKS              0x08
+#define CONFIG_SCHEDULE_MODE_NOISE_FLOOR        0x10
+#define CONFIG_SCHEDULE_MODE_ONSETS             0x20
+#define CONFIG_SCHEDULE_MODE_FEATURES           0x40
+#define CONFIG_SCHEDULE_MODE_LEVELS             0x80
+#define CONFIG_SCHEDULE_MODE_ALL                0xFF
+
+typedef enum {CONFIG_REFERENCE_ABSOLUTE, CONFIG_REFERENCE_DAWN, CONFIG_REFERENCE_DUSK} CONFIG_reference_t;
+
+/* Configuration settings. The size must be a multiple of four to be written to flash and the CRC must be the last field */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint8_t startReference;
+    uint8_t endReference;
+    uint8_t event;
+    uint8_t mode;
+    int16_t startMinutes;
+    int16_t endMinutes;
+    uint32_t sampleInterval;
+} scheduleWindow_t;
+
+typedef struct {
+    uint16_t version;
+    uint16_t size;
+    uint32_t sampleInterval;
+    uint32_t sampleRate;
+    uint16_t buffersToCollect;
+    uint16_t oversampleRate;
+    uint8_t clockDivider;
+    uint8_t acquisitionCycles;
+    uint8_t gainRange;
+    uint8_t gain;
+    int32_t latitude;
+    int32_t longitude;
+    uint8_t numberOfScheduleWindows;
+    uint8_t heartbeatInterval;
+    scheduleWindow_t scheduleWindows[CONFIG_MAXIMUM_SCHEDULE_WINDOWS];
+    int16_t levelCalibration;
+    uint16_t reserved;
+    uint16_t crc;
+} configSettings_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+uint16_t Config_calculateCRC(configSettings_t *settings);
+
+bool Config_isValid(configSettings_t *settings, uint32_t samplesPerBuffer);
+
+bool Config_save(configSettings_t *settings, uint32_t samplesPerBuffer);
+
+void Config_load(configSettings_t *settings, const configSettings_t *defaultSettings, uint32_t samplesPerBuffer);
+
+#endif /* __CONFIG_H */
@@ -0,0 +1,14 @@
+/****************************************************************************
+ * crc.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __CRC_H
+#define __CRC_H
+
+#include <stdint.h>
+
+uint16_t CRC_update(uint16_t crc, const uint8_t *bytes, uint32_t length);
+
+#endif /* __CRC_H */
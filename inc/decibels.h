@@ -0,0 +1,51 @@
+/****************************************************************************
+ * decibels.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __DECIBELS_H
+#define __DECIBELS_H
+
+#include <stdint.h>
+#include <string.h>
+
+/* Decibel constants. Logarithms are returned in Q16 */
+
+#define DECIBELS_PER_DOUBLING                   3.0103f
+
+#define DECIBELS_LOG_FRACTION_BITS              16
+#define DECIBELS_LOG_CORRECTION                 22713
+
+#define DECIBELS_FLOAT_EXPONENT_BIAS            127
+#define DECIBELS_FLOAT_MANTISSA_BITS            23
+
+/* Shared functions. These are inline as they are called for every bin of every frame */
+
+static inline int32_t Decibels_fastLog2(float value) {
+
+    /* The exponent gives the integer part and log2(1 + f) ~ f + 0.3466 * f * (1 - f) gives the fraction to within 0.01 */
+
+    uint32_t bits;
+
+    memcpy(&bits, &value, sizeof(float));
+
+    int32_t exponent = (int32_t)(bits >> DECIBELS_FLOAT_MANTISSA_BITS) - DECIBELS_FLOAT_EXPONENT_BIAS;
+
+    uint32_t fraction = (bits & ((1 << DECIBELS_FLOAT_MANTISSA_BITS) - 1)) >> (DECIBELS_FLOAT_MANTISSA_BITS - DECIBELS_LOG_FRACTION_BITS);
+
+    uint32_t correction = ((fraction * ((1 << DECIBELS_LOG_FRACTION_BITS) - fraction)) >> DECIBELS_LOG_FRACTION_BITS) * DECIBELS_LOG_CORRECTION >> DECIBELS_LOG_FRACTION_BITS;
+
+    return (exponent << DECIBELS_LOG_FRACTION_BITS) + (int32_t)(fraction + correction);
+
+}
+
+static inline float Decibels_powerNormalisation(uint32_t amplitudeNormalisingConstant) {
+
+    /* A full scale sine wave has a bin amplitude of half the normalising constant, so this scales its power to 0 dB */
+
+    return 4.0f / (float)amplitudeNormalisingConstant / (float)amplitudeNormalisingConstant;
+
+}
+
+#endif /* __DECIBELS_H */
@@ -0,0 +1,60 @@
+/****************************************************************************
+ * download.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __DOWNLOAD_H
+#define __DOWNLOAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Download messages carried in byte 1 of the application packets */
+
+#define DOWNLOAD_MESSAGE_LIST                   0x03
+#define DOWNLOAD_MESSAGE_OPEN                   0x04
+#define DOWNLOAD_MESSAGE_SEEK                   0x05
+#define DOWNLOAD_MESSAGE_CLOSE                  0x06
+#define DOWNLOAD_MESSAGE_DATA                   0x07
+
+/* Reply status carried in byte 1 of the requested packets */
+
+#define DOWNLOAD_STATUS_BUSY                    0
+#define DOWNLOAD_STATUS_OK                      1
+#define DOWNLOAD_STATUS_ERROR                   2
+
+/* Packet layout */
+
+#define DOWNLOAD_PACKET_SIZE                    64
+#define DOWNLOAD_FILENAME_OFFSET                8
+#define DOWNLOAD_MAXIMUM_FILENAME_LENGTH        (DOWNLOAD_PACKET_SIZE - DOWNLOAD_FILENAME_OFFSET)
+#define DOWNLOAD_CHUNK_HEADER_SIZE              12
+#define DOWNLOAD_CHUNK_DATA_SIZE                (DOWNLOAD_PACKET_SIZE - DOWNLOAD_CHUNK_HEADER_SIZE)
+
+/* Read ahead buffers. The workspace holds two buffers of whole sectors which are filled alternately from the file */
+
+#define DOWNLOAD_BYTES_PER_BUFFER               4096
+#define DOWNLOAD_WORKSPACE_SIZE                 (2 * DOWNLOAD_BYTES_PER_BUFFER)
+
+#define DOWNLOAD_FILE_EXTENSION                 ".BIN"
+
+/* Useful macro */
+
+#define DOWNLOAD_IS_MESSAGE(message)            ((message) >= DOWNLOAD_MESSAGE_LIST && (message) <= DOWNLOAD_MESSAGE_CLOSE)
+
+/* Functions called from the main loop */
+
+void Download_initialise(uint8_t *workspace);
+
+void Download_loop(void);
+
+void Download_stop(void);
+
+/* Functions called from the USB interrupt */
+
+void Download_packetReceived(uint8_t *receiveBuffer, uint8_t *transmitBuffer, uint32_t size);
+
+void Download_packetRequested(uint8_t *transmitBuffer, uint32_t size);
+
+#endif /* __DOWNLOAD_H */
@@ -0,0 +1,792 @@
+/****************************************************************************
+ * dpss_tables.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+ 
+#include <stdint.h>
+
+/* Global constants */
+
+#define DPSS_LENGTH                 1024
+#define DPSS_NUMBER_OF_TAPERS       3
+#define DPSS_TIME_BANDWIDTH         4.0f
+
+/* Discrete prolate spheroidal sequences with NW = 4.0. Each taper is scaled so its sum of squares matches the Hann window in the FFT tables, giving the same 1.5 bin noise bandwidth. The fractions of their energy leaking outside the 4.0 bin half bandwidth are 2.9e-10, 2.8e-08, 1.2e-06 */
+
+static const float dpssTapers[DPSS_NUMBER_OF_TAPERS][DPSS_LENGTH] = {
+    {
+        0.000000109304f,  0.000000124882f,  0.000000141548f,  0.000000159351f,
+        0.000000178339f,  0.000000198561f,  0.000000220070f,  0.000000242917f,
+        0.000000267158f,  0.000000292847f,  0.000000320042f,  0.000000348802f,
+        0.000000379186f,  0.000000411256f,  0.000000445075f,  0.000000480709f,
+        0.000000518222f,  0.000000557684f,  0.000000599163f,  0.000000642731f,
+        0.000000688461f,  0.000000736428f,  0.000000786707f,  0.000000839376f,
+        0.000000894517f,  0.000000952209f,  0.000001012537f,  0.000001075585f,
+        0.000001141442f,  0.000001210194f,  0.000001281935f,  0.000001356755f,
+        0.000001434750f,  0.000001516016f,  0.000001600652f,  0.000001688758f,
+        0.000001780438f,  0.000001875794f,  0.000001974934f,  0.000002077967f,
+        0.000002185002f,  0.000002296154f,  0.000002411537f,  0.000002531267f,
+        0.000002655464f,  0.000002784249f,  0.000002917746f,  0.000003056081f,
+        0.000003199381f,  0.000003347776f,  0.000003501399f,  0.000003660384f,
+        0.000003824869f,  0.000003994992f,  0.000004170894f,  0.000004352720f,
+        0.000004540616f,  0.000004734730f,  0.000004935212f,  0.000005142217f,
+        0.000005355898f,  0.000005576415f,  0.000005803927f,  0.000006038597f,
+        0.000006280590f,  0.000006530074f,  0.000006787217f,  0.000007052194f,
+        0.000007325178f,  0.000007606346f,  0.000007895878f,  0.000008193957f,
+        0.000008500766f,  0.000008816494f,  0.000009141328f,  0.000009475461f,
+        0.000009819089f,  0.000010172406f,  0.000010535613f,  0.000010908912f,
+        0.000011292507f,  0.000011686604f,  0.000012091414f,  0.000012507147f,
+        0.000012934018f,  0.000013372243f,  0.000013822043f,  0.000014283637f,
+        0.000014757250f,  0.000015243110f,  0.000015741444f,  0.000016252483f,
+        0.000016776463f,  0.000017313618f,  0.000017864187f,  0.000018428412f,
+        0.000019006536f,  0.000019598803f,  0.000020205464f,  0.000020826767f,
+        0.000021462965f,  0.000022114314f,  0.000022781070f,  0.000023463494f,
+        0.000024161847f,  0.000024876393f,  0.000025607399f,  0.000026355133f,
+        0.000027119865f,  0.000027901868f,  0.000028701418f,  0.000029518792f,
+        0.000030354268f,  0.000031208127f,  0.000032080654f,  0.000032972132f,
+        0.000033882850f,  0.000034813096f,  0.000035763161f,  0.000036733339f,
+        0.000037723924f,  0.000038735212f,  0.000039767502f,  0.000040821094f,
+        0.000041896290f,  0.000042993393f,  0.000044112709f,  0.000045254544f,
+        0.000046419206f,  0.000047607005f,  0.000048818253f,  0.000050053262f,
+        0.000051312346f,  0.000052595821f,  0.000053904003f,  0.000055237211f,
+        0.000056595764f,  0.000057979982f,  0.000059390186f,  0.000060826700f,
+        0.000062289846f,  0.000063779950f,  0.000065297336f,  0.000066842332f,
+        0.000068415264f,  0.000070016460f,  0.000071646249f,  0.000073304960f,
+        0.000074992924f,  0.000076710469f,  0.000078457927f,  0.000080235630f,
+        0.000082043908f,  0.000083883095f,  0.000085753521f,  0.000087655519f,
+        0.000089589422f,  0.000091555561f,  0.000093554270f,  0.000095585881f,
+        0.000097650724f,  0.000099749134f,  0.000101881440f,  0.000104047975f,
+        0.000106249069f,  0.000108485051f,  0.000110756253f,  0.000113063003f,
+        0.000115405629f,  0.000117784459f,  0.000120199819f,  0.000122652035f,
+        0.000125141432f,  0.000127668333f,  0.000130233061f,  0.000132835936f,
+        0.000135477280f,  0.000138157409f,  0.000140876641f,  0.000143635291f,
+        0.000146433674f,  0.000149272100f,  0.000152150881f,  0.000155070324f,
+        0.000158030735f,  0.000161032420f,  0.000164075680f,  0.000167160814f,
+        0.000170288122f,  0.000173457897f,  0.000176670433f,  0.000179926020f,
+        0.000183224945f,  0.000186567494f,  0.000189953948f,  0.000193384586f,
+        0.000196859685f,  0.000200379518f,  0.000203944354f,  0.000207554461f,
+        0.000211210102f,  0.000214911536f,  0.000218659020f,  0.000222452808f,
+        0.000226293147f,  0.000230180284f,  0.000234114461f,  0.000238095915f,
+        0.000242124878f,  0.000246201583f,  0.000250326252f,  0.000254499108f,
+        0.000258720366f,  0.000262990240f,  0.000267308937f,  0.000271676660f,
+        0.000276093607f,  0.000280559971f,  0.000285075942f,  0.000289641702f,
+        0.000294257431f,  0.000298923301f,  0.000303639481f,  0.000308406134f,
+        0.000313223416f,  0.000318091481f,  0.000323010474f,  0.000327980536f,
+        0.000333001802f,  0.000338074401f,  0.000343198456f,  0.000348374085f,
+        0.000353601399f,  0.000358880502f,  0.000364211493f,  0.000369594466f,
+        0.000375029505f,  0.000380516691f,  0.000386056097f,  0.000391647789f,
+        0.000397291828f,  0.000402988265f,  0.000408737148f,  0.000414538515f,
+        0.000420392399f,  0.000426298825f,  0.000432257811f,  0.000438269368f,
+        0.000444333500f,  0.000450450203f,  0.000456619466f,  0.000462841271f,
+        0.000469115590f,  0.000475442392f,  0.000481821633f,  0.000488253266f,
+        0.000494737234f,  0.000501273471f,  0.000507861905f,  0.000514502457f,
+        0.000521195036f,  0.000527939547f,  0.000534735885f,  0.000541583937f,
+        0.000548483582f,  0.000555434690f,  0.000562437125f,  0.000569490740f,
+        0.000576595380f,  0.000583750883f,  0.000590957077f,  0.000598213782f,
+        0.000605520811f,  0.000612877965f,  0.000620285039f,  0.000627741819f,
+        0.000635248082f,  0.000642803595f,  0.000650408118f,  0.000658061402f,
+        0.000665763188f,  0.000673513208f,  0.000681311188f,  0.000689156842f,
+        0.000697049876f,  0.000704989988f,  0.000712976865f,  0.000721010186f,
+        0.000729089623f,  0.000737214836f,  0.000745385478f,  0.000753601191f,
+        0.000761861610f,  0.000770166360f,  0.000778515057f,  0.000786907308f,
+        0.000795342712f,  0.000803820857f,  0.000812341323f,  0.000820903681f,
+        0.000829507493f,  0.000838152312f,  0.000846837682f,  0.000855563138f,
+        0.000864328206f,  0.000873132402f,  0.000881975236f,  0.000890856205f,
+        0.000899774801f,  0.000908730505f,  0.000917722790f,  0.000926751119f,
+        0.000935814947f,  0.000944913722f,  0.000954046879f,  0.000963213849f,
+        0.000972414052f,  0.000981646899f,  0.000990911793f,  0.001000208130f,
+        0.001009535296f,  0.001018892668f,  0.001028279616f,  0.001037695501f,
+        0.001047139677f,  0.001056611487f,  0.001066110269f,  0.001075635350f,
+        0.001085186053f,  0.001094761689f,  0.001104361563f,  0.001113984973f,
+        0.001123631206f,  0.001133299546f,  0.001142989266f,  0.001152699632f,
+        0.001162429903f,  0.001172179332f,  0.001181947162f,  0.001191732631f,
+        0.001201534969f,  0.001211353399f,  0.001221187137f,  0.001231035393f,
+        0.001240897369f,  0.001250772261f,  0.001260659259f,  0.001270557545f,
+        0.001280466297f,  0.001290384684f,  0.001300311871f,  0.001310247016f,
+        0.001320189272f,  0.001330137784f,  0.001340091693f,  0.001350050135f,
+        0.001360012239f,  0.001369977130f,  0.001379943926f,  0.001389911742f,
+        0.001399879685f,  0.001409846861f,  0.001419812368f,  0.001429775301f,
+        0.001439734749f,  0.001449689799f,  0.001459639532f,  0.001469583025f,
+        0.001479519351f,  0.001489447580f,  0.001499366776f,  0.001509276003f,
+        0.001519174319f,  0.001529060779f,  0.001538934434f,  0.001548794335f,
+        0.001558639527f,  0.001568469053f,  0.001578281954f,  0.001588077268f,
+        0.001597854032f,  0.001607611279f,  0.001617348040f,  0.001627063347f,
+        0.001636756225f,  0.001646425703f,  0.001656070806f,  0.001665690556f,
+        0.001675283978f,  0.001684850091f,  0.001694387919f,  0.001703896480f,
+        0.001713374795f,  0.001722821884f,  0.001732236764f,  0.001741618456f,
+        0.001750965979f,  0.001760278353f,  0.001769554598f,  0.001778793734f,
+        0.001787994783f,  0.001797156768f,  0.001806278713f,  0.001815359641f,
+        0.001824398579f,  0.001833394556f,  0.001842346600f,  0.001851253743f,
+        0.001860115020f,  0.001868929465f,  0.001877696117f,  0.001886414017f,
+        0.001895082208f,  0.001903699736f,  0.001912265652f,  0.001920779008f,
+        0.001929238859f,  0.001937644267f,  0.001945994293f,  0.001954288005f,
+        0.001962524475f,  0.001970702778f,  0.001978821993f,  0.001986881205f,
+        0.001994879503f,  0.002002815981f,  0.002010689737f,  0.002018499876f,
+        0.002026245507f,  0.002033925744f,  0.002041539709f,  0.002049086526f,
+        0.002056565329f,  0.002063975255f,  0.002071315449f,  0.002078585062f,
+        0.002085783250f,  0.002092909180f,  0.002099962020f,  0.002106940949f,
+        0.002113845153f,  0.002120673824f,  0.002127426161f,  0.002134101372f,
+        0.002140698672f,  0.002147217285f,  0.002153656441f,  0.002160015380f,
+        0.002166293349f,  0.002172489604f,  0.002178603410f,  0.002184634040f,
+        0.002190580776f,  0.002196442909f,  0.002202219740f,  0.002207910577f,
+        0.002213514740f,  0.002219031557f,  0.002224460366f,  0.002229800514f,
+        0.002235051358f,  0.002240212267f,  0.002245282618f,  0.002250261798f,
+        0.002255149206f,  0.002259944249f,  0.002264646348f,  0.002269254932f,
+        0.002273769440f,  0.002278189325f,  0.002282514049f,  0.002286743085f,
+        0.002290875917f,  0.002294912041f,  0.002298850965f,  0.002302692207f,
+        0.002306435297f,  0.002310079777f,  0.002313625200f,  0.002317071131f,
+        0.002320417148f,  0.002323662839f,  0.002326807807f,  0.002329851663f,
+        0.002332794034f,  0.002335634556f,  0.002338372881f,  0.002341008671f,
+        0.002343541599f,  0.002345971354f,  0.002348297636f,  0.002350520157f,
+        0.002352638643f,  0.002354652831f,  0.002356562472f,  0.002358367330f,
+        0.002360067182f,  0.002361661816f,  0.002363151036f,  0.002364534656f,
+        0.002365812506f,  0.002366984425f,  0.002368050271f,  0.002369009909f,
+        0.002369863221f,  0.002370610101f,  0.002371250456f,  0.002371784207f,
+        0.002372211287f,  0.002372531644f,  0.002372745237f,  0.002372852040f,
+        0.002372852040f,  0.002372745237f,  0.002372531644f,  0.002372211287f,
+        0.002371784207f,  0.002371250456f,  0.002370610101f,  0.002369863221f,
+        0.002369009909f,  0.002368050271f,  0.002366984425f,  0.002365812506f,
+        0.002364534656f,  0.002363151036f,  0.002361661816f,  0.002360067182f,
+        0.002358367330f,  0.002356562472f,  0.002354652831f,  0.002352638643f,
+        0.002350520157f,  0.002348297636f,  0.002345971354f,  0.002343541599f,
+        0.002341008671f,  0.002338372881f,  0.002335634556f,  0.002332794034f,
+        0.002329851663f,  0.002326807807f,  0.002323662839f,  0.002320417148f,
+        0.002317071131f,  0.002313625200f,  0.002310079777f,  0.002306435297f,
+        0.002302692207f,  0.002298850965f,  0.002294912041f,  0.002290875917f,
+        0.002286743085f,  0.002282514049f,  0.002278189325f,  0.002273769440f,
+        0.002269254932f,  0.002264646348f,  0.002259944249f,  0.002255149206f,
+        0.002250261798f,  0.002245282618f,  0.002240212267f,  0.002235051358f,
+        0.002229800514f,  0.002224460366f,  0.002219031557f,  0.002213514740f,
+        0.002207910577f,  0.002202219740f,  0.002196442909f,  0.002190580776f,
+        0.002184634040f,  0.002178603410f,  0.002172489604f,  0.002166293349f,
+        0.002160015380f,  0.002153656441f,  0.002147217285f,  0.002140698672f,
+        0.002134101372f,  0.002127426161f,  0.002120673824f,  0.002113845153f,
+        0.002106940949f,  0.002099962020f,  0.002092909180f,  0.002085783250f,
+        0.002078585062f,  0.002071315449f,  0.002063975255f,  0.002056565329f,
+        0.002049086526f,  0.002041539709f,  0.002033925744f,  0.002026245507f,
+        0.002018499876f,  0.002010689737f,  0.002002815981f,  0.001994879503f,
+        0.001986881205f,  0.001978821993f,  0.001970702778f,  0.001962524475f,
+        0.001954288005f,  0.001945994293f,  0.001937644267f,  0.001929238859f,
+        0.001920779008f,  0.001912265652f,  0.001903699736f,  0.001895082208f,
+        0.001886414017f,  0.001877696117f,  0.001868929465f,  0.001860115020f,
+        0.001851253743f,  0.001842346600f,  0.001833394556f,  0.001824398579f,
+        0.001815359641f,  0.001806278713f,  0.001797156768f,  0.001787994783f,
+        0.001778793734f,  0.001769554598f,  0.001760278353f,  0.001750965979f,
+        0.001741618456f,  0.001732236764f,  0.001722821884f,  0.001713374795f,
+        0.001703896480f,  0.001694387919f,  0.001684850091f,  0.001675283978f,
+        0.001665690556f,  0.001656070806f,  0.001646425703f,  0.001636756225f,
+        0.001627063347f,  0.001617348040f,  0.001607611279f,  0.001597854032f,
+        0.001588077268f,  0.001578281954f,  0.001568469053f,  0.001558639527f,
+        0.001548794335f,  0.001538934434f,  0.001529060779f,  0.001519174319f,
+        0.001509276003f,  0.001499366776f,  0.001489447580f,  0.001479519351f,
+        0.001469583025f,  0.001459639532f,  0.001449689799f,  0.001439734749f,
+        0.001429775301f,  0.001419812368f,  0.001409846861f,  0.001399879685f,
+        0.001389911742f,  0.001379943926f,  0.001369977130f,  0.001360012239f,
+        0.001350050135f,  0.001340091693f,  0.001330137784f,  0.001320189272f,
+        0.001310247016f,  0.001300311871f,  0.001290384684f,  0.001280466297f,
+        0.001270557545f,  0.001260659259f,  0.001250772261f,  0.001240897369f,
+        0.001231035393f,  0.001221187137f,  0.001211353399f,  0.001201534969f,
+        0.001191732631f,  0.001181947162f,  0.001172179332f,  0.001162429903f,
+        0.001152699632f,  0.001142989266f,  0.001133299546f,  0.001123631206f,
+        0.001113984973f,  0.001104361563f,  0.001094761689f,  0.001085186053f,
+        0.001075635350f,  0.001066110269f,  0.001056611487f,  0.001047139677f,
+        0.001037695501f,  0.001028279616f,  0.001018892668f,  0.001009535296f,
+        0.001000208130f,  0.000990911793f,  0.000981646899f,  0.000972414052f,
+        0.000963213849f,  0.000954046879f,  0.000944913722f,  0.000935814947f,
+        0.000926751119f,  0.000917722790f,  0.000908730505f,  0.000899774801f,
+        0.000890856205f,  0.000881975236f,  0.000873132402f,  0.000864328206f,
+        0.000855563138f,  0.000846837682f,  0.000838152312f,  0.000829507493f,
+        0.000820903681f,  0.000812341323f,  0.000803820857f,  0.000795342712f,
+        0.000786907308f,  0.000778515057f,  0.000770166360f,  0.000761861610f,
+        0.000753601191f,  0.000745385478f,  0.000737214836f,  0.000729089623f,
+        0.000721010186f,  0.000712976865f,  0.000704989988f,  0.000697049876f,
+        0.000689156842f,  0.000681311188f,  0.000673513208f,  0.000665763188f,
+        0.000658061402f,  0.000650408118f,  0.000642803595f,  0.000635248082f,
+        0.000627741819f,  0.000620285039f,  0.000612877965f,  0.000605520811f,
+        0.000598213782f,  0.000590957077f,  0.000583750883f,  0.000576595380f,
+        0.000569490740f,  0.000562437125f,  0.000555434690f,  0.000548483582f,
+        0.000541583937f,  0.000534735885f,  0.000527939547f,  0.000521195036f,
+        0.000514502457f,  0.000507861905f,  0.000501273471f,  0.000494737234f,
+        0.000488253266f,  0.000481821633f,  0.000475442392f,  0.000469115590f,
+        0.000462841271f,  0.000456619466f,  0.000450450203f,  0.000444333500f,
+        0.000438269368f,  0.000432257811f,  0.000426298825f,  0.000420392399f,
+        0.000414538515f,  0.000408737148f,  0.000402988265f,  0.000397291828f,
+        0.000391647789f,  0.000386056097f,  0.000380516691f,  0.000375029505f,
+        0.000369594466f,  0.000364211493f,  0.000358880502f,  0.000353601399f,
+        0.000348374085f,  0.000343198456f,  0.000338074401f,  0.000333001802f,
+        0.000327980536f,  0.000323010474f,  0.000318091481f,  0.000313223416f,
+        0.000308406134f,  0.000303639481f,  0.000298923301f,  0.000294257431f,
+        0.000289641702f,  0.000285075942f,  0.000280559971f,  0.000276093607f,
+        0.000271676660f,  0.000267308937f,  0.000262990240f,  0.000258720366f,
+        0.000254499108f,  0.000250326252f,  0.000246201583f,  0.000242124878f,
+        0.000238095915f,  0.000234114461f,  0.000230180284f,  0.000226293147f,
+        0.000222452808f,  0.000218659020f,  0.000214911536f,  0.000211210102f,
+        0.000207554461f,  0.000203944354f,  0.000200379518f,  0.000196859685f,
+        0.000193384586f,  0.000189953948f,  0.000186567494f,  0.000183224945f,
+        0.000179926020f,  0.000176670433f,  0.000173457897f,  0.000170288122f,
+        0.000167160814f,  0.000164075680f,  0.000161032420f,  0.000158030735f,
+        0.000155070324f,  0.000152150881f,  0.000149272100f,  0.000146433674f,
+        0.000143635291f,  0.000140876641f,  0.000138157409f,  0.000135477280f,
+        0.000132835936f,  0.000130233061f,  0.000127668333f,  0.000125141432f,
+        0.000122652035f,  0.000120199819f,  0.000117784459f,  0.000115405629f,
+        0.000113063003f,  0.000110756253f,  0.000108485051f,  0.000106249069f,
+        0.000104047975f,  0.000101881440f,  0.000099749134f,  0.000097650724f,
+        0.000095585881f,  0.000093554270f,  0.000091555561f,  0.000089589422f,
+        0.000087655519f,  0.000085753521f,  0.000083883095f,  0.000082043908f,
+        0.000080235630f,  0.000078457927f,  0.000076710469f,  0.000074992924f,
+        0.000073304960f,  0.000071646249f,  0.000070016460f,  0.000068415264f,
+        0.000066842332f,  0.000065297336f,  0.000063779950f,  0.000062289846f,
+        0.000060826700f,  0.000059390186f,  0.000057979982f,  0.000056595764f,
+        0.000055237211f,  0.000053904003f,  0.000052595821f,  0.000051312346f,
+        0.000050053262f,  0.000048818253f,  0.000047607005f,  0.000046419206f,
+        0.000045254544f,  0.000044112709f,  0.000042993393f,  0.000041896290f,
+        0.000040821094f,  0.000039767502f,  0.000038735212f,  0.000037723924f,
+        0.000036733339f,  0.000035763161f,  0.000034813096f,  0.000033882850f,
+        0.000032972132f,  0.000032080654f,  0.000031208127f,  0.000030354268f,
+        0.000029518792f,  0.000028701418f,  0.000027901868f,  0.000027119865f,
+        0.000026355133f,  0.000025607399f,  0.000024876393f,  0.000024161847f,
+        0.000023463494f,  0.000022781070f,  0.000022114314f,  0.000021462965f,
+        0.000020826767f,  0.000020205464f,  0.000019598803f,  0.000019006536f,
+        0.000018428412f,  0.000017864187f,  0.000017313618f,  0.000016776463f,
+        0.000016252483f,  0.000015741444f,  0.000015243110f,  0.000014757250f,
+        0.000014283637f,  0.000013822043f,  0.000013372243f,  0.000012934018f,
+        0.000012507147f,  0.000012091414f,  0.000011686604f,  0.000011292507f,
+        0.000010908912f,  0.000010535613f,  0.000010172406f,  0.000009819089f,
+        0.000009475461f,  0.000009141328f,  0.000008816494f,  0.000008500766f,
+        0.000008193957f,  0.000007895878f,  0.000007606346f,  0.000007325178f,
+        0.000007052194f,  0.000006787217f,  0.000006530074f,  0.000006280590f,
+        0.000006038597f,  0.000005803927f,  0.000005576415f,  0.000005355898f,
+        0.000005142217f,  0.000004935212f,  0.000004734730f,  0.000004540616f,
+        0.000004352720f,  0.000004170894f,  0.000003994992f,  0.000003824869f,
+        0.000003660384f,  0.000003501399f,  0.000003347776f,  0.000003199381f,
+        0.000003056081f,  0.000002917746f,  0.000002784249f,  0.000002655464f,
+        0.000002531267f,  0.000002411537f,  0.000002296154f,  0.000002185002f,
+        0.000002077967f,  0.000001974934f,  0.000001875794f,  0.000001780438f,
+        0.000001688758f,  0.000001600652f,  0.000001516016f,  0.000001434750f,
+        0.000001356755f,  0.000001281935f,  0.000001210194f,  0.000001141442f,
+        0.000001075585f,  0.000001012537f,  0.000000952209f,  0.000000894517f,
+        0.000000839376f,  0.000000786707f,  0.000000736428f,  0.000000688461f,
+        0.000000642731f,  0.000000599163f,  0.000000557684f,  0.000000518222f,
+        0.000000480709f,  0.000000445075f,  0.000000411256f,  0.000000379186f,
+        0.000000348802f,  0.000000320042f,  0.000000292847f,  0.000000267158f,
+        0.000000242917f,  0.000000220070f,  0.000000198561f,  0.000000178339f,
+        0.000000159351f,  0.000000141548f,  0.000000124882f,  0.000000109304f
+    },
+    {
+       -0.000001024051f, -0.000001145913f, -0.000001274808f, -0.000001410976f,
+       -0.000001554665f, -0.000001706127f, -0.000001865617f, -0.000002033396f,
+       -0.000002209731f, -0.000002394892f, -0.000002589156f, -0.000002792802f,
+       -0.000003006117f, -0.000003229390f, -0.000003462917f, -0.000003706999f,
+       -0.000003961940f, -0.000004228051f, -0.000004505648f, -0.000004795049f,
+       -0.000005096581f, -0.000005410574f, -0.000005737362f, -0.000006077285f,
+       -0.000006430689f, -0.000006797923f, -0.000007179342f, -0.000007575306f,
+       -0.000007986180f, -0.000008412333f, -0.000008854140f, -0.000009311979f,
+       -0.000009786235f, -0.000010277297f, -0.000010785558f, -0.000011311418f,
+       -0.000011855278f, -0.000012417548f, -0.000012998639f, -0.000013598969f,
+       -0.000014218959f, -0.000014859036f, -0.000015519630f, -0.000016201177f,
+       -0.000016904116f, -0.000017628892f, -0.000018375952f, -0.000019145749f,
+       -0.000019938740f, -0.000020755385f, -0.000021596151f, -0.000022461504f,
+       -0.000023351919f, -0.000024267873f, -0.000025209845f, -0.000026178320f,
+       -0.000027173786f, -0.000028196735f, -0.000029247661f, -0.000030327064f,
+       -0.000031435444f, -0.000032573306f, -0.000033741160f, -0.000034939516f,
+       -0.000036168888f, -0.000037429793f, -0.000038722752f, -0.000040048286f,
+       -0.000041406921f, -0.000042799184f, -0.000044225605f, -0.000045686716f,
+       -0.000047183051f, -0.000048715146f, -0.000050283541f, -0.000051888773f,
+       -0.000053531386f, -0.000055211921f, -0.000056930923f, -0.000058688938f,
+       -0.000060486513f, -0.000062324195f, -0.000064202533f, -0.000066122077f,
+       -0.000068083375f, -0.000070086979f, -0.000072133438f, -0.000074223305f,
+       -0.000076357129f, -0.000078535460f, -0.000080758850f, -0.000083027847f,
+       -0.000085343002f, -0.000087704861f, -0.000090113973f, -0.000092570883f,
+       -0.000095076137f, -0.000097630277f, -0.000100233846f, -0.000102887383f,
+       -0.000105591427f, -0.000108346513f, -0.000111153175f, -0.000114011944f,
+       -0.000116923347f, -0.000119887911f, -0.000122906157f, -0.000125978605f,
+       -0.000129105771f, -0.000132288165f, -0.000135526297f, -0.000138820670f,
+       -0.000142171785f, -0.000145580138f, -0.000149046218f, -0.000152570512f,
+       -0.000156153502f, -0.000159795663f, -0.000163497467f, -0.000167259378f,
+       -0.000171081855f, -0.000174965351f, -0.000178910315f, -0.000182917186f,
+       -0.000186986398f, -0.000191118379f, -0.000195313550f, -0.000199572322f,
+       -0.000203895102f, -0.000208282288f, -0.000212734269f, -0.000217251429f,
+       -0.000221834140f, -0.000226482768f, -0.000231197669f, -0.000235979193f,
+       -0.000240827676f, -0.000245743449f, -0.000250726831f, -0.000255778133f,
+       -0.000260897655f, -0.000266085686f, -0.000271342507f, -0.000276668387f,
+       -0.000282063584f, -0.000287528346f, -0.000293062908f, -0.000298667497f,
+       -0.000304342324f, -0.000310087593f, -0.000315903491f, -0.000321790198f,
+       -0.000327747877f, -0.000333776681f, -0.000339876750f, -0.000346048210f,
+       -0.000352291176f, -0.000358605746f, -0.000364992009f, -0.000371450035f,
+       -0.000377979886f, -0.000384581604f, -0.000391255222f, -0.000398000754f,
+       -0.000404818202f, -0.000411707553f, -0.000418668778f, -0.000425701834f,
+       -0.000432806661f, -0.000439983185f, -0.000447231315f, -0.000454550946f,
+       -0.000461941954f, -0.000469404203f, -0.000476937536f, -0.000484541783f,
+       -0.000492216756f, -0.000499962250f, -0.000507778043f, -0.000515663897f,
+       -0.000523619556f, -0.000531644746f, -0.000539739177f, -0.000547902540f,
+       -0.000556134509f, -0.000564434739f, -0.000572802870f, -0.000581238520f,
+       -0.000589741292f, -0.000598310767f, -0.000606946512f, -0.000615648073f,
+       -0.000624414977f, -0.000633246733f, -0.000642142832f, -0.000651102744f,
+       -0.000660125922f, -0.000669211799f, -0.000678359789f, -0.000687569287f,
+       -0.000696839669f, -0.000706170291f, -0.000715560490f, -0.000725009584f,
+       -0.000734516870f, -0.000744081627f, -0.000753703114f, -0.000763380572f,
+       -0.000773113218f, -0.000782900255f, -0.000792740862f, -0.000802634201f,
+       -0.000812579412f, -0.000822575618f, -0.000832621921f, -0.000842717403f,
+       -0.000852861127f, -0.000863052135f, -0.000873289453f, -0.000883572083f,
+       -0.000893899011f, -0.000904269200f, -0.000914681598f, -0.000925135131f,
+       -0.000935628704f, -0.000946161207f, -0.000956731507f, -0.000967338454f,
+       -0.000977980879f, -0.000988657592f, -0.000999367386f, -0.001010109036f,
+       -0.001020881295f, -0.001031682901f, -0.001042512572f, -0.001053369008f,
+       -0.001064250889f, -0.001075156880f, -0.001086085626f, -0.001097035755f,
+       -0.001108005877f, -0.001118994583f, -0.001130000451f, -0.001141022036f,
+       -0.001152057881f, -0.001163106510f, -0.001174166429f, -0.001185236131f,
+       -0.001196314089f, -0.001207398761f, -0.001218488592f, -0.001229582007f,
+       -0.001240677418f, -0.001251773222f, -0.001262867799f, -0.001273959515f,
+       -0.001285046724f, -0.001296127761f, -0.001307200950f, -0.001318264601f,
+       -0.001329317011f, -0.001340356460f, -0.001351381219f, -0.001362389545f,
+       -0.001373379681f, -0.001384349860f, -0.001395298302f, -0.001406223216f,
+       -0.001417122797f, -0.001427995233f, -0.001438838698f, -0.001449651358f,
+       -0.001460431366f, -0.001471176869f, -0.001481886000f, -0.001492556887f,
+       -0.001503187647f, -0.001513776389f, -0.001524321213f, -0.001534820213f,
+       -0.001545271475f, -0.001555673076f, -0.001566023089f, -0.001576319579f,
+       -0.001586560606f, -0.001596744224f, -0.001606868480f, -0.001616931420f,
+       -0.001626931081f, -0.001636865500f, -0.001646732708f, -0.001656530733f,
+       -0.001666257601f, -0.001675911333f, -0.001685489952f, -0.001694991475f,
+       -0.001704413921f, -0.001713755306f, -0.001723013647f, -0.001732186959f,
+       -0.001741273260f, -0.001750270567f, -0.001759176899f, -0.001767990276f,
+       -0.001776708720f, -0.001785330256f, -0.001793852912f, -0.001802274719f,
+       -0.001810593712f, -0.001818807931f, -0.001826915419f, -0.001834914226f,
+       -0.001842802405f, -0.001850578018f, -0.001858239132f, -0.001865783821f,
+       -0.001873210165f, -0.001880516255f, -0.001887700187f, -0.001894760067f,
+       -0.001901694012f, -0.001908500145f, -0.001915176601f, -0.001921721526f,
+       -0.001928133076f, -0.001934409418f, -0.001940548733f, -0.001946549211f,
+       -0.001952409057f, -0.001958126490f, -0.001963699739f, -0.001969127051f,
+       -0.001974406685f, -0.001979536916f, -0.001984516034f, -0.001989342345f,
+       -0.001994014172f, -0.001998529854f, -0.002002887746f, -0.002007086222f,
+       -0.002011123674f, -0.002014998512f, -0.002018709165f, -0.002022254081f,
+       -0.002025631729f, -0.002028840596f, -0.002031879191f, -0.002034746044f,
+       -0.002037439705f, -0.002039958747f, -0.002042301766f, -0.002044467378f,
+       -0.002046454224f, -0.002048260968f, -0.002049886297f, -0.002051328922f,
+       -0.002052587581f, -0.002053661035f, -0.002054548068f, -0.002055247495f,
+       -0.002055758152f, -0.002056078903f, -0.002056208641f, -0.002056146282f,
+       -0.002055890773f, -0.002055441087f, -0.002054796225f, -0.002053955218f,
+       -0.002052917122f, -0.002051681027f, -0.002050246049f, -0.002048611334f,
+       -0.002046776060f, -0.002044739433f, -0.002042500691f, -0.002040059102f,
+       -0.002037413966f, -0.002034564613f, -0.002031510406f, -0.002028250740f,
+       -0.002024785041f, -0.002021112768f, -0.002017233413f, -0.002013146502f,
+       -0.002008851591f, -0.002004348271f, -0.001999636169f, -0.001994714942f,
+       -0.001989584282f, -0.001984243917f, -0.001978693608f, -0.001972933149f,
+       -0.001966962372f, -0.001960781140f, -0.001954389355f, -0.001947786952f,
+       -0.001940973901f, -0.001933950208f, -0.001926715915f, -0.001919271098f,
+       -0.001911615871f, -0.001903750383f, -0.001895674818f, -0.001887389397f,
+       -0.001878894377f, -0.001870190052f, -0.001861276750f, -0.001852154837f,
+       -0.001842824716f, -0.001833286824f, -0.001823541637f, -0.001813589666f,
+       -0.001803431458f, -0.001793067597f, -0.001782498704f, -0.001771725436f,
+       -0.001760748486f, -0.001749568584f, -0.001738186495f, -0.001726603023f,
+       -0.001714819004f, -0.001702835315f, -0.001690652864f, -0.001678272600f,
+       -0.001665695505f, -0.001652922595f, -0.001639954927f, -0.001626793589f,
+       -0.001613439705f, -0.001599894437f, -0.001586158980f, -0.001572234563f,
+       -0.001558122453f, -0.001543823949f, -0.001529340385f, -0.001514673130f,
+       -0.001499823587f, -0.001484793193f, -0.001469583418f, -0.001454195767f,
+       -0.001438631775f, -0.001422893015f, -0.001406981088f, -0.001390897630f,
+       -0.001374644309f, -0.001358222826f, -0.001341634911f, -0.001324882328f,
+       -0.001307966872f, -0.001290890366f, -0.001273654668f, -0.001256261663f,
+       -0.001238713268f, -0.001221011427f, -0.001203158115f, -0.001185155337f,
+       -0.001167005126f, -0.001148709540f, -0.001130270670f, -0.001111690631f,
+       -0.001092971567f, -0.001074115647f, -0.001055125068f, -0.001036002052f,
+       -0.001016748846f, -0.000997367725f, -0.000977860986f, -0.000958230950f,
+       -0.000938479964f, -0.000918610397f, -0.000898624642f, -0.000878525113f,
+       -0.000858314248f, -0.000837994506f, -0.000817568367f, -0.000797038331f,
+       -0.000776406919f, -0.000755676673f, -0.000734850153f, -0.000713929937f,
+       -0.000692918622f, -0.000671818825f, -0.000650633176f, -0.000629364326f,
+       -0.000608014941f, -0.000586587701f, -0.000565085303f, -0.000543510459f,
+       -0.000521865895f, -0.000500154349f, -0.000478378574f, -0.000456541336f,
+       -0.000434645412f, -0.000412693591f, -0.000390688672f, -0.000368633467f,
+       -0.000346530794f, -0.000324383485f, -0.000302194376f, -0.000279966316f,
+       -0.000257702158f, -0.000235404764f, -0.000213077002f, -0.000190721746f,
+       -0.000168341875f, -0.000145940275f, -0.000123519832f, -0.000101083441f,
+       -0.000078633996f, -0.000056174396f, -0.000033707540f, -0.000011236330f,
+        0.000011236330f,  0.000033707540f,  0.000056174396f,  0.000078633996f,
+        0.000101083441f,  0.000123519832f,  0.000145940275f,  0.000168341875f,
+        0.000190721746f,  0.000213077002f,  0.000235404764f,  0.000257702158f,
+        0.000279966316f,  0.000302194377f,  0.000324383485f,  0.000346530794f,
+        0.000368633467f,  0.000390688673f,  0.000412693591f,  0.000434645412f,
+        0.000456541337f,  0.000478378574f,  0.000500154349f,  0.000521865895f,
+        0.000543510459f,  0.000565085303f,  0.000586587701f,  0.000608014941f,
+        0.000629364327f,  0.000650633176f,  0.000671818825f,  0.000692918622f,
+        0.000713929937f,  0.000734850153f,  0.000755676673f,  0.000776406920f,
+        0.000797038331f,  0.000817568367f,  0.000837994506f,  0.000858314248f,
+        0.000878525113f,  0.000898624642f,  0.000918610397f,  0.000938479964f,
+        0.000958230950f,  0.000977860986f,  0.000997367725f,  0.001016748847f,
+        0.001036002052f,  0.001055125068f,  0.001074115647f,  0.001092971567f,
+        0.001111690631f,  0.001130270670f,  0.001148709540f,  0.001167005126f,
+        0.001185155338f,  0.001203158115f,  0.001221011427f,  0.001238713268f,
+        0.001256261664f,  0.001273654668f,  0.001290890367f,  0.001307966872f,
+        0.001324882328f,  0.001341634911f,  0.001358222826f,  0.001374644309f,
+        0.001390897630f,  0.001406981088f,  0.001422893015f,  0.001438631775f,
+        0.001454195767f,  0.001469583419f,  0.001484793193f,  0.001499823587f,
+        0.001514673130f,  0.001529340385f,  0.001543823949f,  0.001558122453f,
+        0.001572234564f,  0.001586158980f,  0.001599894438f,  0.001613439706f,
+        0.001626793589f,  0.001639954927f,  0.001652922596f,  0.001665695505f,
+        0.001678272600f,  0.001690652865f,  0.001702835315f,  0.001714819004f,
+        0.001726603023f,  0.001738186495f,  0.001749568584f,  0.001760748486f,
+        0.001771725436f,  0.001782498704f,  0.001793067597f,  0.001803431458f,
+        0.001813589666f,  0.001823541637f,  0.001833286825f,  0.001842824716f,
+        0.001852154838f,  0.001861276750f,  0.001870190052f,  0.001878894378f,
+        0.001887389397f,  0.001895674818f,  0.001903750383f,  0.001911615871f,
+        0.001919271098f,  0.001926715915f,  0.001933950208f,  0.001940973901f,
+        0.001947786952f,  0.001954389356f,  0.001960781140f,  0.001966962372f,
+        0.001972933149f,  0.001978693608f,  0.001984243918f,  0.001989584283f,
+        0.001994714942f,  0.001999636169f,  0.002004348272f,  0.002008851591f,
+        0.002013146502f,  0.002017233413f,  0.002021112768f,  0.002024785041f,
+        0.002028250740f,  0.002031510406f,  0.002034564613f,  0.002037413966f,
+        0.002040059102f,  0.002042500691f,  0.002044739434f,  0.002046776060f,
+        0.002048611334f,  0.002050246049f,  0.002051681027f,  0.002052917122f,
+        0.002053955218f,  0.002054796226f,  0.002055441087f,  0.002055890774f,
+        0.002056146282f,  0.002056208641f,  0.002056078903f,  0.002055758152f,
+        0.002055247495f,  0.002054548069f,  0.002053661035f,  0.002052587582f,
+        0.002051328923f,  0.002049886297f,  0.002048260968f,  0.002046454224f,
+        0.002044467378f,  0.002042301766f,  0.002039958748f,  0.002037439705f,
+        0.002034746044f,  0.002031879192f,  0.002028840596f,  0.002025631729f,
+        0.002022254082f,  0.002018709165f,  0.002014998512f,  0.002011123674f,
+        0.002007086222f,  0.002002887746f,  0.001998529854f,  0.001994014173f,
+        0.001989342346f,  0.001984516034f,  0.001979536916f,  0.001974406685f,
+        0.001969127051f,  0.001963699739f,  0.001958126490f,  0.001952409058f,
+        0.001946549211f,  0.001940548733f,  0.001934409418f,  0.001928133076f,
+        0.001921721526f,  0.001915176601f,  0.001908500145f,  0.001901694012f,
+        0.001894760068f,  0.001887700187f,  0.001880516255f,  0.001873210165f,
+        0.001865783821f,  0.001858239132f,  0.001850578019f,  0.001842802406f,
+        0.001834914226f,  0.001826915420f,  0.001818807931f,  0.001810593713f,
+        0.001802274719f,  0.001793852912f,  0.001785330256f,  0.001776708720f,
+        0.001767990276f,  0.001759176899f,  0.001750270568f,  0.001741273261f,
+        0.001732186960f,  0.001723013647f,  0.001713755306f,  0.001704413921f,
+        0.001694991475f,  0.001685489952f,  0.001675911334f,  0.001666257601f,
+        0.001656530734f,  0.001646732709f,  0.001636865501f,  0.001626931081f,
+        0.001616931420f,  0.001606868480f,  0.001596744224f,  0.001586560607f,
+        0.001576319580f,  0.001566023089f,  0.001555673076f,  0.001545271475f,
+        0.001534820214f,  0.001524321213f,  0.001513776389f,  0.001503187647f,
+        0.001492556887f,  0.001481886000f,  0.001471176869f,  0.001460431367f,
+        0.001449651358f,  0.001438838699f,  0.001427995233f,  0.001417122798f,
+        0.001406223216f,  0.001395298303f,  0.001384349861f,  0.001373379681f,
+        0.001362389545f,  0.001351381219f,  0.001340356460f,  0.001329317011f,
+        0.001318264602f,  0.001307200950f,  0.001296127761f,  0.001285046724f,
+        0.001273959516f,  0.001262867799f,  0.001251773222f,  0.001240677419f,
+        0.001229582007f,  0.001218488592f,  0.001207398762f,  0.001196314089f,
+        0.001185236131f,  0.001174166430f,  0.001163106510f,  0.001152057882f,
+        0.001141022036f,  0.001130000451f,  0.001118994583f,  0.001108005877f,
+        0.001097035755f,  0.001086085626f,  0.001075156880f,  0.001064250889f,
+        0.001053369008f,  0.001042512572f,  0.001031682901f,  0.001020881295f,
+        0.001010109036f,  0.000999367386f,  0.000988657592f,  0.000977980879f,
+        0.000967338454f,  0.000956731507f,  0.000946161207f,  0.000935628704f,
+        0.000925135131f,  0.000914681599f,  0.000904269201f,  0.000893899011f,
+        0.000883572083f,  0.000873289453f,  0.000863052136f,  0.000852861127f,
+        0.000842717403f,  0.000832621921f,  0.000822575619f,  0.000812579412f,
+        0.000802634201f,  0.000792740862f,  0.000782900255f,  0.000773113218f,
+        0.000763380572f,  0.000753703114f,  0.000744081627f,  0.000734516870f,
+        0.000725009584f,  0.000715560490f,  0.000706170291f,  0.000696839670f,
+        0.000687569288f,  0.000678359789f,  0.000669211799f,  0.000660125922f,
+        0.000651102744f,  0.000642142832f,  0.000633246733f,  0.000624414977f,
+        0.000615648073f,  0.000606946513f,  0.000598310767f,  0.000589741292f,
+        0.000581238520f,  0.000572802870f,  0.000564434740f,  0.000556134509f,
+        0.000547902540f,  0.000539739177f,  0.000531644746f,  0.000523619556f,
+        0.000515663897f,  0.000507778043f,  0.000499962250f,  0.000492216756f,
+        0.000484541783f,  0.000476937536f,  0.000469404203f,  0.000461941954f,
+        0.000454550946f,  0.000447231315f,  0.000439983185f,  0.000432806661f,
+        0.000425701834f,  0.000418668778f,  0.000411707553f,  0.000404818202f,
+        0.000398000754f,  0.000391255222f,  0.000384581604f,  0.000377979886f,
+        0.000371450035f,  0.000364992009f,  0.000358605746f,  0.000352291176f,
+        0.000346048210f,  0.000339876750f,  0.000333776681f,  0.000327747877f,
+        0.000321790198f,  0.000315903491f,  0.000310087593f,  0.000304342324f,
+        0.000298667497f,  0.000293062908f,  0.000287528346f,  0.000282063584f,
+        0.000276668387f,  0.000271342507f,  0.000266085686f,  0.000260897655f,
+        0.000255778133f,  0.000250726831f,  0.000245743449f,  0.000240827676f,
+        0.000235979193f,  0.000231197669f,  0.000226482768f,  0.000221834140f,
+        0.000217251429f,  0.000212734269f,  0.000208282288f,  0.000203895102f,
+        0.000199572322f,  0.000195313550f,  0.000191118380f,  0.000186986398f,
+        0.000182917186f,  0.000178910315f,  0.000174965351f,  0.000171081855f,
+        0.000167259378f,  0.000163497467f,  0.000159795664f,  0.000156153502f,
+        0.000152570512f,  0.000149046218f,  0.000145580138f,  0.000142171786f,
+        0.000138820671f,  0.000135526297f,  0.000132288165f,  0.000129105771f,
+        0.000125978605f,  0.000122906157f,  0.000119887911f,  0.000116923347f,
+        0.000114011944f,  0.000111153175f,  0.000108346513f,  0.000105591427f,
+        0.000102887383f,  0.000100233846f,  0.000097630277f,  0.000095076137f,
+        0.000092570883f,  0.000090113973f,  0.000087704861f,  0.000085343002f,
+        0.000083027847f,  0.000080758850f,  0.000078535460f,  0.000076357129f,
+        0.000074223305f,  0.000072133438f,  0.000070086979f,  0.000068083375f,
+        0.000066122077f,  0.000064202533f,  0.000062324195f,  0.000060486513f,
+        0.000058688938f,  0.000056930923f,  0.000055211921f,  0.000053531386f,
+        0.000051888773f,  0.000050283541f,  0.000048715146f,  0.000047183051f,
+        0.000045686716f,  0.000044225605f,  0.000042799184f,  0.000041406921f,
+        0.000040048286f,  0.000038722752f,  0.000037429793f,  0.000036168888f,
+        0.000034939516f,  0.000033741160f,  0.000032573306f,  0.000031435444f,
+        0.000030327064f,  0.000029247661f,  0.000028196735f,  0.000027173786f,
+        0.000026178320f,  0.000025209845f,  0.000024267873f,  0.000023351919f,
+        0.000022461504f,  0.000021596151f,  0.000020755385f,  0.000019938740f,
+        0.000019145749f,  0.000018375952f,  0.000017628892f,  0.000016904116f,
+        0.000016201177f,  0.000015519630f,  0.000014859036f,  0.000014218959f,
+        0.000013598969f,  0.000012998639f,  0.000012417548f,  0.000011855278f,
+        0.000011311418f,  0.000010785558f,  0.000010277297f,  0.000009786235f,
+        0.000009311979f,  0.000008854140f,  0.000008412333f,  0.000007986180f,
+        0.000007575306f,  0.000007179342f,  0.000006797923f,  0.000006430689f,
+        0.000006077285f,  0.000005737362f,  0.000005410574f,  0.000005096581f,
+        0.000004795049f,  0.000004505648f,  0.000004228051f,  0.000003961940f,
+        0.000003706999f,  0.000003462917f,  0.000003229390f,  0.000003006117f,
+        0.000002792802f,  0.000002589156f,  0.000002394892f,  0.000002209731f,
+        0.000002033396f,  0.000001865617f,  0.000001706127f,  0.000001554665f,
+        0.000001410976f,  0.000001274808f,  0.000001145913f,  0.000001024051f
+    },
+    {
+        0.000006527230f,  0.000007157601f,  0.000007816903f,  0.000008505862f,
+        0.000009225215f,  0.000009975702f,  0.000010758071f,  0.000011573078f,
+        0.000012421483f,  0.000013304054f,  0.000014221565f,  0.000015174792f,
+        0.000016164523f,  0.000017191546f,  0.000018256657f,  0.000019360656f,
+        0.000020504347f,  0.000021688542f,  0.000022914054f,  0.000024181700f,
+        0.000025492304f,  0.000026846691f,  0.000028245690f,  0.000029690135f,
+        0.000031180859f,  0.000032718703f,  0.000034304507f,  0.000035939113f,
+        0.000037623366f,  0.000039358114f,  0.000041144204f,  0.000042982485f,
+        0.000044873808f,  0.000046819023f,  0.000048818980f,  0.000050874532f,
+        0.000052986527f,  0.000055155816f,  0.000057383248f,  0.000059669671f,
+        0.000062015930f,  0.000064422870f,  0.000066891333f,  0.000069422158f,
+        0.000072016181f,  0.000074674237f,  0.000077397155f,  0.000080185760f,
+        0.000083040875f,  0.000085963316f,  0.000088953895f,  0.000092013420f,
+        0.000095142692f,  0.000098342505f,  0.000101613648f,  0.000104956904f,
+        0.000108373047f,  0.000111862845f,  0.000115427058f,  0.000119066436f,
+        0.000122781722f,  0.000126573651f,  0.000130442946f,  0.000134390323f,
+        0.000138416485f,  0.000142522126f,  0.000146707931f,  0.000150974569f,
+        0.000155322703f,  0.000159752979f,  0.000164266032f,  0.000168862487f,
+        0.000173542952f,  0.000178308023f,  0.000183158281f,  0.000188094295f,
+        0.000193116616f,  0.000198225782f,  0.000203422315f,  0.000208706721f,
+        0.000214079488f,  0.000219541089f,  0.000225091981f,  0.000230732600f,
+        0.000236463367f,  0.000242284684f,  0.000248196932f,  0.000254200478f,
+        0.000260295664f,  0.000266482815f,  0.000272762236f,  0.000279134211f,
+        0.000285599003f,  0.000292156853f,  0.000298807981f,  0.000305552585f,
+        0.000312390841f,  0.000319322901f,  0.000326348896f,  0.000333468931f,
+        0.000340683088f,  0.000347991427f,  0.000355393981f,  0.000362890760f,
+        0.000370481746f,  0.000378166900f,  0.000385946153f,  0.000393819413f,
+        0.000401786560f,  0.000409847447f,  0.000418001903f,  0.000426249725f,
+        0.000434590687f,  0.000443024533f,  0.000451550978f,  0.000460169712f,
+        0.000468880392f,  0.000477682650f,  0.000486576087f,  0.000495560275f,
+        0.000504634756f,  0.000513799044f,  0.000523052620f,  0.000532394938f,
+        0.000541825420f,  0.000551343457f,  0.000560948411f,  0.000570639610f,
+        0.000580416353f,  0.000590277909f,  0.000600223513f,  0.000610252369f,
+        0.000620363651f,  0.000630556498f,  0.000640830021f,  0.000651183295f,
+        0.000661615367f,  0.000672125247f,  0.000682711917f,  0.000693374325f,
+        0.000704111385f,  0.000714921980f,  0.000725804961f,  0.000736759145f,
+        0.000747783319f,  0.000758876233f,  0.000770036609f,  0.000781263134f,
+        0.000792554462f,  0.000803909216f,  0.000815325986f,  0.000826803329f,
+        0.000838339770f,  0.000849933802f,  0.000861583886f,  0.000873288450f,
+        0.000885045890f,  0.000896854572f,  0.000908712827f,  0.000920618958f,
+        0.000932571234f,  0.000944567894f,  0.000956607144f,  0.000968687162f,
+        0.000980806094f,  0.000992962054f,  0.001005153128f,  0.001017377371f,
+        0.001029632807f,  0.001041917434f,  0.001054229216f,  0.001066566091f,
+        0.001078925968f,  0.001091306727f,  0.001103706221f,  0.001116122273f,
+        0.001128552681f,  0.001140995215f,  0.001153447617f,  0.001165907605f,
+        0.001178372869f,  0.001190841075f,  0.001203309864f,  0.001215776849f,
+        0.001228239624f,  0.001240695754f,  0.001253142784f,  0.001265578234f,
+        0.001277999604f,  0.001290404369f,  0.001302789984f,  0.001315153884f,
+        0.001327493481f,  0.001339806169f,  0.001352089323f,  0.001364340296f,
+        0.001376556427f,  0.001388735034f,  0.001400873420f,  0.001412968869f,
+        0.001425018651f,  0.001437020021f,  0.001448970216f,  0.001460866463f,
+        0.001472705974f,  0.001484485946f,  0.001496203566f,  0.001507856010f,
+        0.001519440442f,  0.001530954016f,  0.001542393876f,  0.001553757158f,
+        0.001565040990f,  0.001576242491f,  0.001587358777f,  0.001598386953f,
+        0.001609324123f,  0.001620167385f,  0.001630913833f,  0.001641560558f,
+        0.001652104650f,  0.001662543197f,  0.001672873285f,  0.001683092001f,
+        0.001693196435f,  0.001703183676f,  0.001713050816f,  0.001722794951f,
+        0.001732413181f,  0.001741902610f,  0.001751260350f,  0.001760483518f,
+        0.001769569237f,  0.001778514641f,  0.001787316872f,  0.001795973081f,
+        0.001804480431f,  0.001812836096f,  0.001821037262f,  0.001829081129f,
+        0.001836964910f,  0.001844685835f,  0.001852241148f,  0.001859628110f,
+        0.001866844000f,  0.001873886116f,  0.001880751772f,  0.001887438307f,
+        0.001893943076f,  0.001900263459f,  0.001906396859f,  0.001912340699f,
+        0.001918092430f,  0.001923649525f,  0.001929009487f,  0.001934169842f,
+        0.001939128146f,  0.001943881982f,  0.001948428964f,  0.001952766734f,
+        0.001956892968f,  0.001960805372f,  0.001964501685f,  0.001967979679f,
+        0.001971237161f,  0.001974271973f,  0.001977081993f,  0.001979665135f,
+        0.001982019353f,  0.001984142635f,  0.001986033011f,  0.001987688552f,
+        0.001989107366f,  0.001990287606f,  0.001991227464f,  0.001991925177f,
+        0.001992379025f,  0.001992587332f,  0.001992548468f,  0.001992260847f,
+        0.001991722932f,  0.001990933230f,  0.001989890298f,  0.001988592741f,
+        0.001987039213f,  0.001985228419f,  0.001983159113f,  0.001980830099f,
+        0.001978240236f,  0.001975388433f,  0.001972273652f,  0.001968894908f,
+        0.001965251273f,  0.001961341870f,  0.001957165879f,  0.001952722536f,
+        0.001948011132f,  0.001943031014f,  0.001937781590f,  0.001932262321f,
+        0.001926472730f,  0.001920412396f,  0.001914080958f,  0.001907478115f,
+        0.001900603624f,  0.001893457305f,  0.001886039036f,  0.001878348759f,
+        0.001870386473f,  0.001862152244f,  0.001853646195f,  0.001844868514f,
+        0.001835819452f,  0.001826499321f,  0.001816908498f,  0.001807047421f,
+        0.001796916594f,  0.001786516583f,  0.001775848019f,  0.001764911597f,
+        0.001753708075f,  0.001742238276f,  0.001730503089f,  0.001718503466f,
+        0.001706240423f,  0.001693715042f,  0.001680928470f,  0.001667881918f,
+        0.001654576661f,  0.001641014042f,  0.001627195464f,  0.001613122398f,
+        0.001598796379f,  0.001584219007f,  0.001569391944f,  0.001554316920f,
+        0.001538995725f,  0.001523430217f,  0.001507622315f,  0.001491574004f,
+        0.001475287329f,  0.001458764401f,  0.001442007393f,  0.001425018541f,
+        0.001407800143f,  0.001390354559f,  0.001372684211f,  0.001354791582f,
+        0.001336679216f,  0.001318349718f,  0.001299805753f,  0.001281050045f,
+        0.001262085379f,  0.001242914598f,  0.001223540602f,  0.001203966352f,
+        0.001184194863f,  0.001164229210f,  0.001144072522f,  0.001123727984f,
+        0.001103198838f,  0.001082488379f,  0.001061599956f,  0.001040536971f,
+        0.001019302880f,  0.000997901190f,  0.000976335459f,  0.000954609297f,
+        0.000932726363f,  0.000910690364f,  0.000888505056f,  0.000866174245f,
+        0.000843701781f,  0.000821091561f,  0.000798347526f,  0.000775473664f,
+        0.000752474005f,  0.000729352620f,  0.000706113625f,  0.000682761176f,
+        0.000659299466f,  0.000635732732f,  0.000612065245f,  0.000588301315f,
+        0.000564445289f,  0.000540501547f,  0.000516474505f,  0.000492368613f,
+        0.000468188351f,  0.000443938231f,  0.000419622797f,  0.000395246620f,
+        0.000370814300f,  0.000346330465f,  0.000321799766f,  0.000297226882f,
+        0.000272616515f,  0.000247973388f,  0.000223302249f,  0.000198607862f,
+        0.000173895015f,  0.000149168510f,  0.000124433169f,  0.000099693828f,
+        0.000074955338f,  0.000050222565f,  0.000025500386f,  0.000000793690f,
+       -0.000023892626f, -0.000048553654f, -0.000073184479f, -0.000097780181f,
+       -0.000122335832f, -0.000146846503f, -0.000171307262f, -0.000195713172f,
+       -0.000220059301f, -0.000244340714f, -0.000268552479f, -0.000292689670f,
+       -0.000316747362f, -0.000340720638f, -0.000364604587f, -0.000388394309f,
+       -0.000412084910f, -0.000435671509f, -0.000459149238f, -0.000482513240f,
+       -0.000505758674f, -0.000528880714f, -0.000551874553f, -0.000574735400f,
+       -0.000597458484f, -0.000620039056f, -0.000642472388f, -0.000664753775f,
+       -0.000686878537f, -0.000708842020f, -0.000730639596f, -0.000752266665f,
+       -0.000773718657f, -0.000794991032f, -0.000816079281f, -0.000836978928f,
+       -0.000857685533f, -0.000878194688f, -0.000898502023f, -0.000918603205f,
+       -0.000938493940f, -0.000958169973f, -0.000977627091f, -0.000996861121f,
+       -0.001015867934f, -0.001034643447f, -0.001053183618f, -0.001071484455f,
+       -0.001089542011f, -0.001107352390f, -0.001124911742f, -0.001142216269f,
+       -0.001159262226f, -0.001176045918f, -0.001192563705f, -0.001208812000f,
+       -0.001224787273f, -0.001240486049f, -0.001255904910f, -0.001271040497f,
+       -0.001285889510f, -0.001300448708f, -0.001314714913f, -0.001328685006f,
+       -0.001342355931f, -0.001355724697f, -0.001368788375f, -0.001381544102f,
+       -0.001393989081f, -0.001406120580f, -0.001417935936f, -0.001429432552f,
+       -0.001440607901f, -0.001451459525f, -0.001461985034f, -0.001472182112f,
+       -0.001482048511f, -0.001491582057f, -0.001500780647f, -0.001509642252f,
+       -0.001518164915f, -0.001526346755f, -0.001534185964f, -0.001541680809f,
+       -0.001548829634f, -0.001555630857f, -0.001562082974f, -0.001568184558f,
+       -0.001573934256f, -0.001579330797f, -0.001584372985f, -0.001589059703f,
+       -0.001593389912f, -0.001597362653f, -0.001600977045f, -0.001604232286f,
+       -0.001607127655f, -0.001609662510f, -0.001611836287f, -0.001613648506f,
+       -0.001615098764f, -0.001616186739f, -0.001616912190f, -0.001617274956f,
+       -0.001617274956f, -0.001616912190f, -0.001616186739f, -0.001615098764f,
+       -0.001613648506f, -0.001611836287f, -0.001609662510f, -0.001607127655f,
+       -0.001604232286f, -0.001600977045f, -0.001597362653f, -0.001593389912f,
+       -0.001589059703f, -0.001584372985f, -0.001579330797f, -0.001573934256f,
+       -0.001568184558f, -0.001562082974f, -0.001555630857f, -0.001548829634f,
+       -0.001541680809f, -0.001534185964f, -0.001526346755f, -0.001518164915f,
+       -0.001509642252f, -0.001500780647f, -0.001491582057f, -0.001482048511f,
+       -0.001472182112f, -0.001461985034f, -0.001451459525f, -0.001440607901f,
+       -0.001429432552f, -0.001417935936f, -0.001406120580f, -0.001393989081f,
+       -0.001381544102f, -0.001368788375f, -0.001355724697f, -0.001342355931f,
+       -0.001328685006f, -0.001314714913f, -0.001300448708f, -0.001285889510f,
+       -0.001271040497f, -0.001255904910f, -0.001240486049f, -0.001224787273f,
+       -0.001208812000f, -0.001192563705f, -0.001176045918f, -0.001159262226f,
+       -0.001142216269f, -0.001124911742f, -0.001107352390f, -0.001089542011f,
+       -0.001071484455f, -0.001053183618f, -0.001034643447f, -0.001015867934f,
+       -0.000996861121f, -0.000977627091f, -0.000958169973f, -0.000938493940f,
+       -0.000918603205f, -0.000898502023f, -0.000878194688f, -0.000857685533f,
+       -0.000836978928f, -0.000816079281f, -0.000794991032f, -0.000773718657f,
+       -0.000752266665f, -0.000730639596f, -0.000708842020f, -0.000686878537f,
+       -0.000664753775f, -0.000642472388f, -0.000620039056f, -0.000597458484f,
+       -0.000574735400f, -0.000551874553f, -0.000528880714f, -0.000505758674f,
+       -0.000482513240f, -0.000459149238f, -0.000435671509f, -0.000412084910f,
+       -0.000388394309f, -0.000364604587f, -0.000340720638f, -0.000316747362f,
+       -0.000292689670f, -0.000268552479f, -0.000244340714f, -0.000220059301f,
+       -0.000195713172f, -0.000171307262f, -0.000146846503f, -0.000122335832f,
+       -0.000097780181f, -0.000073184479f, -0.000048553654f, -0.000023892626f,
+        0.000000793690f,  0.000025500386f,  0.000050222565f,  0.000074955338f,
+        0.000099693828f,  0.000124433169f,  0.000149168510f,  0.000173895015f,
+        0.000198607862f,  0.000223302249f,  0.000247973388f,  0.000272616515f,
+        0.000297226882f,  0.000321799766f,  0.000346330465f,  0.000370814300f,
+        0.000395246620f,  0.000419622797f,  0.000443938231f,  0.000468188351f,
+        0.000492368613f,  0.000516474505f,  0.000540501547f,  0.000564445289f,
+        0.000588301315f,  0.000612065245f,  0.000635732732f,  0.000659299466f,
+        0.000682761176f,  0.000706113625f,  0.000729352620f,  0.000752474005f,
+        0.000775473664f,  0.000798347526f,  0.000821091561f,  0.000843701781f,
+        0.000866174245f,  0.000888505056f,  0.000910690364f,  0.000932726363f,
+        0.000954609297f,  0.000976335459f,  0.000997901190f,  0.001019302880f,
+        0.001040536971f,  0.001061599956f,  0.001082488379f,  0.001103198838f,
+        0.001123727984f,  0.001144072522f,  0.001164229210f,  0.001184194863f,
+        0.001203966352f,  0.001223540602f,  0.001242914598f,  0.001262085379f,
+        0.001281050045f,  0.001299805753f,  0.001318349718f,  0.001336679216f,
+        0.001354791582f,  0.001372684211f,  0.001390354559f,  0.001407800143f,
+        0.001425018541f,  0.001442007393f,  0.001458764401f,  0.001475287329f,
+        0.001491574004f,  0.001507622315f,  0.001523430217f,  0.001538995725f,
+        0.001554316920f,  0.001569391944f,  0.001584219007f,  0.001598796379f,
+        0.001613122398f,  0.001627195464f,  0.001641014042f,  0.001654576661f,
+        0.001667881918f,  0.001680928470f,  0.001693715042f,  0.001706240423f,
+        0.001718503466f,  0.001730503089f,  0.001742238276f,  0.001753708075f,
+        0.001764911597f,  0.001775848019f,  0.001786516583f,  0.001796916594f,
+        0.001807047421f,  0.001816908498f,  0.001826499321f,  0.001835819452f,
+        0.001844868514f,  0.001853646195f,  0.001862152244f,  0.001870386473f,
+        0.001878348759f,  0.001886039036f,  0.001893457305f,  0.001900603624f,
+        0.001907478115f,  0.001914080958f,  0.001920412396f,  0.001926472730f,
+        0.001932262321f,  0.001937781590f,  0.001943031014f,  0.001948011132f,
+        0.001952722536f,  0.001957165879f,  0.001961341870f,  0.001965251273f,
+        0.001968894908f,  0.001972273652f,  0.001975388433f,  0.001978240236f,
+        0.001980830099f,  0.001983159113f,  0.001985228419f,  0.001987039213f,
+        0.001988592741f,  0.001989890298f,  0.001990933230f,  0.001991722932f,
+        0.001992260847f,  0.001992548468f,  0.001992587332f,  0.001992379025f,
+        0.001991925177f,  0.001991227464f,  0.001990287606f,  0.001989107366f,
+        0.001987688552f,  0.001986033011f,  0.001984142635f,  0.001982019353f,
+        0.001979665135f,  0.001977081993f,  0.001974271973f,  0.001971237161f,
+        0.001967979679f,  0.001964501685f,  0.001960805372f,  0.001956892968f,
+        0.001952766734f,  0.001948428964f,  0.001943881982f,  0.001939128146f,
+        0.001934169842f,  0.001929009487f,  0.001923649525f,  0.001918092430f,
+        0.001912340699f,  0.001906396859f,  0.001900263459f,  0.001893943076f,
+        0.001887438307f,  0.001880751772f,  0.001873886116f,  0.001866844000f,
+        0.001859628110f,  0.001852241148f,  0.001844685835f,  0.001836964910f,
+        0.001829081129f,  0.001821037262f,  0.001812836096f,  0.001804480431f,
+        0.001795973081f,  0.001787316872f,  0.001778514641f,  0.001769569237f,
+        0.001760483518f,  0.001751260350f,  0.001741902610f,  0.001732413181f,
+        0.001722794951f,  0.001713050816f,  0.001703183676f,  0.001693196435f,
+        0.001683092001f,  0.001672873285f,  0.001662543197f,  0.001652104650f,
+        0.001641560558f,  0.001630913833f,  0.001620167385f,  0.001609324123f,
+        0.001598386953f,  0.001587358777f,  0.001576242491f,  0.001565040990f,
+        0.001553757158f,  0.001542393876f,  0.001530954016f,  0.001519440442f,
+        0.001507856010f,  0.001496203566f,  0.001484485946f,  0.001472705974f,
+        0.001460866463f,  0.001448970216f,  0.001437020021f,  0.001425018651f,
+        0.001412968869f,  0.001400873420f,  0.001388735034f,  0.001376556427f,
+        0.001364340296f,  0.001352089323f,  0.001339806169f,  0.001327493481f,
+        0.001315153884f,  0.001302789984f,  0.001290404369f,  0.001277999604f,
+        0.001265578234f,  0.001253142784f,  0.001240695754f,  0.001228239624f,
+        0.001215776849f,  0.001203309864f,  0.001190841075f,  0.001178372869f,
+        0.001165907605f,  0.001153447617f,  0.001140995215f,  0.001128552681f,
+        0.001116122273f,  0.001103706221f,  0.001091306727f,  0.001078925968f,
+        0.001066566091f,  0.001054229216f,  0.001041917434f,  0.001029632807f,
+        0.001017377371f,  0.001005153128f,  0.000992962054f,  0.000980806094f,
+        0.000968687162f,  0.000956607144f,  0.000944567894f,  0.000932571234f,
+        0.000920618958f,  0.000908712827f,  0.000896854572f,  0.000885045890f,
+        0.000873288450f,  0.000861583886f,  0.000849933802f,  0.000838339770f,
+        0.000826803329f,  0.000815325986f,  0.000803909216f,  0.000792554462f,
+        0.000781263134f,  0.000770036609f,  0.000758876233f,  0.000747783319f,
+        0.000736759145f,  0.000725804961f,  0.000714921980f,  0.000704111385f,
+        0.000693374325f,  0.000682711917f,  0.000672125247f,  0.000661615367f,
+        0.000651183295f,  0.000640830021f,  0.000630556498f,  0.000620363651f,
+        0.000610252369f,  0.000600223513f,  0.000590277909f,  0.000580416353f,
+        0.000570639610f,  0.000560948411f,  0.000551343457f,  0.000541825420f,
+        0.000532394938f,  0.000523052620f,  0.000513799044f,  0.000504634756f,
+        0.000495560275f,  0.000486576087f,  0.000477682650f,  0.000468880392f,
+        0.000460169712f,  0.000451550978f,  0.000443024533f,  0.000434590687f,
+        0.000426249725f,  0.000418001903f,  0.000409847447f,  0.000401786560f,
+        0.000393819413f,  0.000385946153f,  0.000378166900f,  0.000370481746f,
+        0.000362890760f,  0.000355393981f,  0.000347991427f,  0.000340683088f,
+        0.000333468931f,  0.000326348896f,  0.000319322901f,  0.000312390841f,
+        0.000305552585f,  0.000298807981f,  0.000292156853f,  0.000285599003f,
+        0.000279134211f,  0.000272762236f,  0.000266482815f,  0.000260295664f,
+        0.000254200478f,  0.000248196932f,  0.000242284684f,  0.000236463367f,
+        0.000230732600f,  0.000225091981f,  0.000219541089f,  0.000214079488f,
+        0.000208706721f,  0.000203422315f,  0.000198225782f,  0.000193116616f,
+        0.000188094295f,  0.000183158281f,  0.000178308023f,  0.000173542952f,
+        0.000168862487f,  0.000164266032f,  0.000159752979f,  0.000155322703f,
+        0.000150974569f,  0.000146707931f,  0.000142522126f,  0.000138416485f,
+        0.000134390323f,  0.000130442946f,  0.000126573651f,  0.000122781722f,
+        0.000119066436f,  0.000115427058f,  0.000111862845f,  0.000108373047f,
+        0.000104956904f,  0.000101613648f,  0.000098342505f,  0.000095142692f,
+        0.000092013420f,  0.000088953895f,  0.000085963316f,  0.000083040875f,
+        0.000080185760f,  0.000077397155f,  0.000074674237f,  0.000072016181f,
+        0.000069422158f,  0.000066891333f,  0.000064422870f,  0.000062015930f,
+        0.000059669671f,  0.000057383248f,  0.000055155816f,  0.000052986527f,
+        0.000050874532f,  0.000048818980f,  0.000046819023f,  0.000044873808f,
+        0.000042982485f,  0.000041144204f,  0.000039358114f,  0.000037623366f,
+        0.000035939113f,  0.000034304507f,  0.000032718703f,  0.000031180859f,
+        0.000029690135f,  0.000028245690f,  0.000026846691f,  0.000025492304f,
+        0.000024181700f,  0.000022914054f,  0.000021688542f,  0.000020504347f,
+        0.000019360656f,  0.000018256657f,  0.000017191546f,  0.000016164523f,
+        0.000015174792f,  0.000014221565f,  0.000013304054f,  0.000012421483f,
+        0.000011573078f,  0.000010758071f,  0.000009975702f,  0.000009225215f,
+        0.000008505862f,  0.000007816903f,  0.000007157601f,  0.000006527230f
+    }
+};
@@ -11,6 +11,8 @@
 
 void FFT_realTransform(int16_t *dataBuffer, float *fftBuffer);
 
+void FFT_realTransformWithWindow(int16_t *dataBuffer, const float *window, float *fftBuffer);
+
 void FFT_completeSpectrum(float *fftBuffer);
 
 #endif /* __FFT_H */
\ No newline at end of file
@@ -0,0 +1,51 @@
+/****************************************************************************
+ * indices.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __INDICES_H
+#define __INDICES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Index constants */
+
+#define INDICES_MAXIMUM_NUMBER_OF_BINS          513
+
+#define INDICES_DIVERSITY_BAND_WIDTH            1000
+#define INDICES_DIVERSITY_MAXIMUM_FREQUENCY     10000
+#define INDICES_DIVERSITY_THRESHOLD             -50
+
+#define INDICES_ANTHROPHONY_MINIMUM_FREQUENCY   1000
+#define INDICES_ANTHROPHONY_MAXIMUM_FREQUENCY   2000
+#define INDICES_BIOPHONY_MINIMUM_FREQUENCY      2000
+#define INDICES_BIOPHONY_MAXIMUM_FREQUENCY      8000
+
+/* Soundscape indices for one record. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    float acousticComplexity;
+    float acousticDiversity;
+    float bioacoustic;
+    float normalisedDifference;
+    float spectralEntropy;
+    float temporalEntropy;
+    uint16_t numberOfFrames;
+    uint16_t reserved;
+} indices_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+void Indices_initialise(uint32_t sampleRate, uint32_t fftLength, uint32_t amplitudeNormalisingConstant);
+
+void Indices_update(float *fftBuffer);
+
+void Indices_calculate(indices_t *indices);
+
+#endif /* __INDICES_H */
@@ -0,0 +1,57 @@
+/****************************************************************************
+ * levels.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __LEVELS_H
+#define __LEVELS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Level constants */
+
+#define LEVELS_MAXIMUM_NUMBER_OF_BINS           513
+
+#define LEVELS_WEIGHTING_Z                      0
+#define LEVELS_WEIGHTING_A                      1
+#define LEVELS_WEIGHTING_C                      2
+#define LEVELS_NUMBER_OF_WEIGHTINGS             3
+
+#define LEVELS_STATISTICS_WEIGHTING             LEVELS_WEIGHTING_A
+
+#define LEVELS_HISTOGRAM_FLOOR                  -128
+#define LEVELS_HISTOGRAM_STEPS_PER_DECIBEL      2
+#define LEVELS_HISTOGRAM_SIZE                   256
+
+#define LEVELS_CALIBRATION_STEPS_PER_DECIBEL    100
+
+/* Sound levels of one record in dB, with the calibration from the configuration added. A full scale sine wave is 0 dB before calibration. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    float leq[LEVELS_NUMBER_OF_WEIGHTINGS];
+    float lmax[LEVELS_NUMBER_OF_WEIGHTINGS];
+    float lpeak;
+    float l10;
+    float l50;
+    float l90;
+    int16_t calibration;
+    uint16_t numberOfFrames;
+} levels_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+void Levels_initialise(uint32_t sampleRate, uint32_t fftLength, uint32_t amplitudeNormalisingConstant, int32_t calibration);
+
+void Levels_updatePeak(int16_t *samples);
+
+void Levels_update(float *fftBuffer);
+
+void Levels_calculate(levels_t *levels);
+
+#endif /* __LEVELS_H */
@@ -0,0 +1,71 @@
+/****************************************************************************
+ * mel.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __MEL_H
+#define __MEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Feature constants */
+
+#define MEL_TYPE_LOG_MEL                        0
+#define MEL_TYPE_MFCC                           1
+
+#define MEL_FORMAT_FLOAT                        0
+#define MEL_FORMAT_FIXED_POINT                  1
+
+#define MEL_TYPE                                MEL_TYPE_MFCC
+#define MEL_FIXED_POINT                         false
+
+#define MEL_NUMBER_OF_BANDS                     40
+#define MEL_NUMBER_OF_COEFFICIENTS              13
+
+#define MEL_MAXIMUM_NUMBER_OF_VECTORS           32
+#define MEL_FRAMES_PER_VECTOR                   1
+
+#define MEL_LEVEL_FLOOR                         -126
+#define MEL_STEPS_PER_DECIBEL                   16
+
+#if MEL_TYPE == MEL_TYPE_MFCC
+    #define MEL_NUMBER_OF_VALUES                MEL_NUMBER_OF_COEFFICIENTS
+#else
+    #define MEL_NUMBER_OF_VALUES                MEL_NUMBER_OF_BANDS
+#endif
+
+#if MEL_FIXED_POINT
+    typedef int16_t melValue_t;
+#else
+    typedef float melValue_t;
+#endif
+
+/* Feature vectors of one record. Each vector is the mean over a number of frames of the log-Mel band levels in dB, or their DCT-II. Fixed point values are in steps of 1/16 dB. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint16_t numberOfVectors;
+    uint16_t framesPerVector;
+    uint8_t type;
+    uint8_t format;
+    uint8_t numberOfValues;
+    uint8_t reserved;
+    melValue_t vectors[MEL_MAXIMUM_NUMBER_OF_VECTORS][MEL_NUMBER_OF_VALUES];
+} melFeatures_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+void Mel_initialise(melFeatures_t *features, uint32_t sampleRate, uint32_t fftLength, uint32_t amplitudeNormalisingConstant, uint32_t numberOfFrames);
+
+void Mel_update(melFeatures_t *features, float *fftBuffer);
+
+void Mel_calculateLevels(float *fftBuffer, float *levels);
+
+void Mel_calculate(melFeatures_t *features);
+
+#endif /* __MEL_H */
@@ -0,0 +1,204 @@
+/****************************************************************************
+ * mel_tables.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+ 
+#include <stdint.h>
+
+/* Global constants */
+
+#define DCT_NUMBER_OF_INPUTS        40
+#define DCT_NUMBER_OF_OUTPUTS       13
+
+/* Orthonormal DCT-II matrix. Row i holds the weights of coefficient i */
+
+static const float dctMatrix[DCT_NUMBER_OF_OUTPUTS * DCT_NUMBER_OF_INPUTS] = {
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.158113883008f,  0.158113883008f,  0.158113883008f,  0.158113883008f,
+     0.223434405013f,  0.222056857606f,  0.219310255831f,  0.215211533401f,
+     0.209785960302f,  0.203066986998f,  0.195096038191f,  0.185922257433f,
+     0.175602204133f,  0.164199504851f,  0.151784461019f,  0.138433615512f,
+     0.124229280731f,  0.109259031124f,  0.093615163258f,  0.077394126780f,
+     0.060695929774f,  0.043623522178f,  0.026282161061f,  0.008778761682f,
+    -0.008778761682f, -0.026282161061f, -0.043623522178f, -0.060695929774f,
+    -0.077394126780f, -0.093615163258f, -0.109259031124f, -0.124229280731f,
+    -0.138433615512f, -0.151784461019f, -0.164199504851f, -0.175602204133f,
+    -0.185922257433f, -0.195096038191f, -0.203066986998f, -0.209785960302f,
+    -0.215211533401f, -0.219310255831f, -0.222056857606f, -0.223434405013f,
+     0.222917492618f,  0.217428524129f,  0.206585743772f,  0.190656136784f,
+     0.170031942958f,  0.145220998392f,  0.116834230885f,  0.085570616863f,
+     0.052199970261f,  0.017543987150f, -0.017543987150f, -0.052199970261f,
+    -0.085570616863f, -0.116834230885f, -0.145220998392f, -0.170031942958f,
+    -0.190656136784f, -0.206585743772f, -0.217428524129f, -0.222917492618f,
+    -0.222917492618f, -0.217428524129f, -0.206585743772f, -0.190656136784f,
+    -0.170031942958f, -0.145220998392f, -0.116834230885f, -0.085570616863f,
+    -0.052199970261f, -0.017543987150f,  0.017543987150f,  0.052199970261f,
+     0.085570616863f,  0.116834230885f,  0.145220998392f,  0.170031942958f,
+     0.190656136784f,  0.206585743772f,  0.217428524129f,  0.222917492618f,
+     0.222056857606f,  0.209785960302f,  0.185922257433f,  0.151784461019f,
+     0.109259031124f,  0.060695929774f,  0.008778761682f, -0.043623522178f,
+    -0.093615163258f, -0.138433615512f, -0.175602204133f, -0.203066986998f,
+    -0.219310255831f, -0.223434405013f, -0.215211533401f, -0.195096038191f,
+    -0.164199504851f, -0.124229280731f, -0.077394126780f, -0.026282161061f,
+     0.026282161061f,  0.077394126780f,  0.124229280731f,  0.164199504851f,
+     0.195096038191f,  0.215211533401f,  0.223434405013f,  0.219310255831f,
+     0.203066986998f,  0.175602204133f,  0.138433615512f,  0.093615163258f,
+     0.043623522178f, -0.008778761682f, -0.060695929774f, -0.109259031124f,
+    -0.151784461019f, -0.185922257433f, -0.209785960302f, -0.222056857606f,
+     0.220853827015f,  0.199235115648f,  0.158113883008f,  0.101515361856f,
+     0.034979809785f, -0.034979809785f, -0.101515361856f, -0.158113883008f,
+    -0.199235115648f, -0.220853827015f, -0.220853827015f, -0.199235115648f,
+    -0.158113883008f, -0.101515361856f, -0.034979809785f,  0.034979809785f,
+     0.101515361856f,  0.158113883008f,  0.199235115648f,  0.220853827015f,
+     0.220853827015f,  0.199235115648f,  0.158113883008f,  0.101515361856f,
+     0.034979809785f, -0.034979809785f, -0.101515361856f, -0.158113883008f,
+    -0.199235115648f, -0.220853827015f, -0.220853827015f, -0.199235115648f,
+    -0.158113883008f, -0.101515361856f, -0.034979809785f,  0.034979809785f,
+     0.101515361856f,  0.158113883008f,  0.199235115648f,  0.220853827015f,
+     0.219310255831f,  0.185922257433f,  0.124229280731f,  0.043623522178f,
+    -0.043623522178f, -0.124229280731f, -0.185922257433f, -0.219310255831f,
+    -0.219310255831f, -0.185922257433f, -0.124229280731f, -0.043623522178f,
+     0.043623522178f,  0.124229280731f,  0.185922257433f,  0.219310255831f,
+     0.219310255831f,  0.185922257433f,  0.124229280731f,  0.043623522178f,
+    -0.043623522178f, -0.124229280731f, -0.185922257433f, -0.219310255831f,
+    -0.219310255831f, -0.185922257433f, -0.124229280731f, -0.043623522178f,
+     0.043623522178f,  0.124229280731f,  0.185922257433f,  0.219310255831f,
+     0.219310255831f,  0.185922257433f,  0.124229280731f,  0.043623522178f,
+    -0.043623522178f, -0.124229280731f, -0.185922257433f, -0.219310255831f,
+     0.217428524129f,  0.170031942958f,  0.085570616863f, -0.017543987150f,
+    -0.116834230885f, -0.190656136784f, -0.222917492618f, -0.206585743772f,
+    -0.145220998392f, -0.052199970261f,  0.052199970261f,  0.145220998392f,
+     0.206585743772f,  0.222917492618f,  0.190656136784f,  0.116834230885f,
+     0.017543987150f, -0.085570616863f, -0.170031942958f, -0.217428524129f,
+    -0.217428524129f, -0.170031942958f, -0.085570616863f,  0.017543987150f,
+     0.116834230885f,  0.190656136784f,  0.222917492618f,  0.206585743772f,
+     0.145220998392f,  0.052199970261f, -0.052199970261f, -0.145220998392f,
+    -0.206585743772f, -0.222917492618f, -0.190656136784f, -0.116834230885f,
+    -0.017543987150f,  0.085570616863f,  0.170031942958f,  0.217428524129f,
+     0.215211533401f,  0.151784461019f,  0.043623522178f, -0.077394126780f,
+    -0.175602204133f, -0.222056857606f, -0.203066986998f, -0.124229280731f,
+    -0.008778761682f,  0.109259031124f,  0.195096038191f,  0.223434405013f,
+     0.185922257433f,  0.093615163258f, -0.026282161061f, -0.138433615512f,
+    -0.209785960302f, -0.219310255831f, -0.164199504851f, -0.060695929774f,
+     0.060695929774f,  0.164199504851f,  0.219310255831f,  0.209785960302f,
+     0.138433615512f,  0.026282161061f, -0.093615163258f, -0.185922257433f,
+    -0.223434405013f, -0.195096038191f, -0.109259031124f,  0.008778761682f,
+     0.124229280731f,  0.203066986998f,  0.222056857606f,  0.175602204133f,
+     0.077394126780f, -0.043623522178f, -0.151784461019f, -0.215211533401f,
+     0.212662702088f,  0.131432778030f,  0.000000000000f, -0.131432778030f,
+    -0.212662702088f, -0.212662702088f, -0.131432778030f, -0.000000000000f,
+     0.131432778030f,  0.212662702088f,  0.212662702088f,  0.131432778030f,
+     0.000000000000f, -0.131432778030f, -0.212662702088f, -0.212662702088f,
+    -0.131432778030f, -0.000000000000f,  0.131432778030f,  0.212662702088f,
+     0.212662702088f,  0.131432778030f,  0.000000000000f, -0.131432778030f,
+    -0.212662702088f, -0.212662702088f, -0.131432778030f,  0.000000000000f,
+     0.131432778030f,  0.212662702088f,  0.212662702088f,  0.131432778030f,
+     0.000000000000f, -0.131432778030f, -0.212662702088f, -0.212662702088f,
+    -0.131432778030f, -0.000000000000f,  0.131432778030f,  0.212662702088f,
+     0.209785960302f,  0.109259031124f, -0.043623522178f, -0.175602204133f,
+    -0.223434405013f, -0.164199504851f, -0.026282161061f,  0.124229280731f,
+     0.215211533401f,  0.203066986998f,  0.093615163258f, -0.060695929774f,
+    -0.185922257433f, -0.222056857606f, -0.151784461019f, -0.008778761682f,
+     0.138433615512f,  0.219310255831f,  0.195096038191f,  0.077394126780f,
+    -0.077394126780f, -0.195096038191f, -0.219310255831f, -0.138433615512f,
+     0.008778761682f,  0.151784461019f,  0.222056857606f,  0.185922257433f,
+     0.060695929774f, -0.093615163258f, -0.203066986998f, -0.215211533401f,
+    -0.124229280731f,  0.026282161061f,  0.164199504851f,  0.223434405013f,
+     0.175602204133f,  0.043623522178f, -0.109259031124f, -0.209785960302f,
+     0.206585743772f,  0.085570616863f, -0.085570616863f, -0.206585743772f,
+    -0.206585743772f, -0.085570616863f,  0.085570616863f,  0.206585743772f,
+     0.206585743772f,  0.085570616863f, -0.085570616863f, -0.206585743772f,
+    -0.206585743772f, -0.085570616863f,  0.085570616863f,  0.206585743772f,
+     0.206585743772f,  0.085570616863f, -0.085570616863f, -0.206585743772f,
+    -0.206585743772f, -0.085570616863f,  0.085570616863f,  0.206585743772f,
+     0.206585743772f,  0.085570616863f, -0.085570616863f, -0.206585743772f,
+    -0.206585743772f, -0.085570616863f,  0.085570616863f,  0.206585743772f,
+     0.206585743772f,  0.085570616863f, -0.085570616863f, -0.206585743772f,
+    -0.206585743772f, -0.085570616863f,  0.085570616863f,  0.206585743772f,
+     0.203066986998f,  0.060695929774f, -0.124229280731f, -0.222056857606f,
+    -0.164199504851f,  0.008778761682f,  0.175602204133f,  0.219310255831f,
+     0.109259031124f, -0.077394126780f, -0.209785960302f, -0.195096038191f,
+    -0.043623522178f,  0.138433615512f,  0.223434405013f,  0.151784461019f,
+    -0.026282161061f, -0.185922257433f, -0.215211533401f, -0.093615163258f,
+     0.093615163258f,  0.215211533401f,  0.185922257433f,  0.026282161061f,
+    -0.151784461019f, -0.223434405013f, -0.138433615512f,  0.043623522178f,
+     0.195096038191f,  0.209785960302f,  0.077394126780f, -0.109259031124f,
+    -0.219310255831f, -0.175602204133f, -0.008778761682f,  0.164199504851f,
+     0.222056857606f,  0.124229280731f, -0.060695929774f, -0.203066986998f,
+     0.199235115648f,  0.034979809785f, -0.158113883008f, -0.220853827015f,
+    -0.101515361856f,  0.101515361856f,  0.220853827015f,  0.158113883008f,
+    -0.034979809785f, -0.199235115648f, -0.199235115648f, -0.034979809785f,
+     0.158113883008f,  0.220853827015f,  0.101515361856f, -0.101515361856f,
+    -0.220853827015f, -0.158113883008f,  0.034979809785f,  0.199235115648f,
+     0.199235115648f,  0.034979809785f, -0.158113883008f, -0.220853827015f,
+    -0.101515361856f,  0.101515361856f,  0.220853827015f,  0.158113883008f,
+    -0.034979809785f, -0.199235115648f, -0.199235115648f, -0.034979809785f,
+     0.158113883008f,  0.220853827015f,  0.101515361856f, -0.101515361856f,
+    -0.220853827015f, -0.158113883008f,  0.034979809785f,  0.199235115648f
+};
+
+/* The same matrix in Q15 */
+
+static const int16_t dctMatrixQ15[DCT_NUMBER_OF_OUTPUTS * DCT_NUMBER_OF_INPUTS] = {
+      5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,
+      5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,
+      5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,
+      5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,   5181,
+      7321,   7276,   7186,   7052,   6874,   6654,   6393,   6092,   5754,   5380,
+      4974,   4536,   4071,   3580,   3068,   2536,   1989,   1429,    861,    288,
+      -288,   -861,  -1429,  -1989,  -2536,  -3068,  -3580,  -4071,  -4536,  -4974,
+     -5380,  -5754,  -6092,  -6393,  -6654,  -6874,  -7052,  -7186,  -7276,  -7321,
+      7305,   7125,   6769,   6247,   5572,   4759,   3828,   2804,   1710,    575,
+      -575,  -1710,  -2804,  -3828,  -4759,  -5572,  -6247,  -6769,  -7125,  -7305,
+     -7305,  -7125,  -6769,  -6247,  -5572,  -4759,  -3828,  -2804,  -1710,   -575,
+       575,   1710,   2804,   3828,   4759,   5572,   6247,   6769,   7125,   7305,
+      7276,   6874,   6092,   4974,   3580,   1989,    288,  -1429,  -3068,  -4536,
+     -5754,  -6654,  -7186,  -7321,  -7052,  -6393,  -5380,  -4071,  -2536,   -861,
+       861,   2536,   4071,   5380,   6393,   7052,   7321,   7186,   6654,   5754,
+      4536,   3068,   1429,   -288,  -1989,  -3580,  -4974,  -6092,  -6874,  -7276,
+      7237,   6529,   5181,   3326,   1146,  -1146,  -3326,  -5181,  -6529,  -7237,
+     -7237,  -6529,  -5181,  -3326,  -1146,   1146,   3326,   5181,   6529,   7237,
+      7237,   6529,   5181,   3326,   1146,  -1146,  -3326,  -5181,  -6529,  -7237,
+     -7237,  -6529,  -5181,  -3326,  -1146,   1146,   3326,   5181,   6529,   7237,
+      7186,   6092,   4071,   1429,  -1429,  -4071,  -6092,  -7186,  -7186,  -6092,
+     -4071,  -1429,   1429,   4071,   6092,   7186,   7186,   6092,   4071,   1429,
+     -1429,  -4071,  -6092,  -7186,  -7186,  -6092,  -4071,  -1429,   1429,   4071,
+      6092,   7186,   7186,   6092,   4071,   1429,  -1429,  -4071,  -6092,  -7186,
+      7125,   5572,   2804,   -575,  -3828,  -6247,  -7305,  -6769,  -4759,  -1710,
+      1710,   4759,   6769,   7305,   6247,   3828,    575,  -2804,  -5572,  -7125,
+     -7125,  -5572,  -2804,    575,   3828,   6247,   7305,   6769,   4759,   1710,
+     -1710,  -4759,  -6769,  -7305,  -6247,  -3828,   -575,   2804,   5572,   7125,
+      7052,   4974,   1429,  -2536,  -5754,  -7276,  -6654,  -4071,   -288,   3580,
+      6393,   7321,   6092,   3068,   -861,  -4536,  -6874,  -7186,  -5380,  -1989,
+      1989,   5380,   7186,   6874,   4536,    861,  -3068,  -6092,  -7321,  -6393,
+     -3580,    288,   4071,   6654,   7276,   5754,   2536,  -1429,  -4974,  -7052,
+      6969,   4307,      0,  -4307,  -6969,  -6969,  -4307,      0,   4307,   6969,
+      6969,   4307,      0,  -4307,  -6969,  -6969,  -4307,      0,   4307,   6969,
+      6969,   4307,      0,  -4307,  -6969,  -6969,  -4307,      0,   4307,   6969,
+      6969,   4307,      0,  -4307,  -6969,  -6969,  -4307,      0,   4307,   6969,
+      6874,   3580,  -1429,  -5754,  -7321,  -5380,   -861,   4071,   7052,   6654,
+      3068,  -1989,  -6092,  -7276,  -4974,   -288,   4536,   7186,   6393,   2536,
+     -2536,  -6393,  -7186,  -4536,    288,   4974,   7276,   6092,   1989,  -3068,
+     -6654,  -7052,  -4071,    861,   5380,   7321,   5754,   1429,  -3580,  -6874,
+      6769,   2804,  -2804,  -6769,  -6769,  -2804,   2804,   6769,   6769,   2804,
+     -2804,  -6769,  -6769,  -2804,   2804,   6769,   6769,   2804,  -2804,  -6769,
+     -6769,  -2804,   2804,   6769,   6769,   2804,  -2804,  -6769,  -6769,  -2804,
+      2804,   6769,   6769,   2804,  -2804,  -6769,  -6769,  -2804,   2804,   6769,
+      6654,   1989,  -4071,  -7276,  -5380,    288,   5754,   7186,   3580,  -2536,
+     -6874,  -6393,  -1429,   4536,   7321,   4974,   -861,  -6092,  -7052,  -3068,
+      3068,   7052,   6092,    861,  -4974,  -7321,  -4536,   1429,   6393,   6874,
+      2536,  -3580,  -7186,  -5754,   -288,   5380,   7276,   4071,  -1989,  -6654,
+      6529,   1146,  -5181,  -7237,  -3326,   3326,   7237,   5181,  -1146,  -6529,
+     -6529,  -1146,   5181,   7237,   3326,  -3326,  -7237,  -5181,   1146,   6529,
+      6529,   1146,  -5181,  -7237,  -3326,   3326,   7237,   5181,  -1146,  -6529,
+     -6529,  -1146,   5181,   7237,   3326,  -3326,  -7237,  -5181,   1146,   6529
+};
@@ -18,4 +18,11 @@
 #define MICROSD_CSPIN           6
 #define MICROSD_CLKPIN          5
 
+#define MICROSD_USE_DMA         1
+#define MICROSD_DMA_RX_CHANNEL  1
+#define MICROSD_DMA_TX_CHANNEL  2
+#define MICROSD_DMAREQ_RX       DMAREQ_USART2_RXDATAV
+#define MICROSD_DMAREQ_TX       DMAREQ_USART2_TXBL
+#define MICROSD_BUSY_POLL_BYTES 64
+
 #endif /* __MICROSDCONFIG_H */
@@ -0,0 +1,24 @@
+/****************************************************************************
+ * multitaper.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __MULTITAPER_H
+#define __MULTITAPER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Multitaper constants. These match the taper table */
+
+#define MULTITAPER_LENGTH                       1024
+#define MULTITAPER_NUMBER_OF_TAPERS             3
+
+/* The power buffer takes the mean over the tapers. The FFT buffer is left holding the transform with the first taper only, which is what the frame based modules see */
+
+/* Public functions */
+
+void Multitaper_transform(int16_t *samples, float *fftBuffer, float *powerBuffer, uint32_t numberOfBins, bool isFirstFrame);
+
+#endif /* __MULTITAPER_H */
@@ -0,0 +1,46 @@
+/****************************************************************************
+ * noisefloor.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __NOISEFLOOR_H
+#define __NOISEFLOOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Noise floor constants */
+
+#define NOISE_FLOOR_NUMBER_OF_BANDS             64
+#define NOISE_FLOOR_BINS_PER_BAND               8
+
+#define NOISE_FLOOR_SMOOTHING                   0.7f
+#define NOISE_FLOOR_BIAS                        1.5f
+#define NOISE_FLOOR_MAXIMUM_RISE                2.0f
+
+#define NOISE_FLOOR_LEVEL_FLOOR                 -126
+#define NOISE_FLOOR_STEPS_PER_DECIBEL           2
+
+/* Band levels are packed four to a word so the state can live in the backup domain. Each level is a uint8 where dB = floor + level / steps */
+
+typedef struct {
+    uint32_t numberOfUpdates;
+    uint32_t levels[NOISE_FLOOR_NUMBER_OF_BANDS / sizeof(uint32_t)];
+} noiseFloorState_t;
+
+/* Public functions */
+
+void NoiseFloor_reset(noiseFloorState_t *state);
+
+void NoiseFloor_initialise(uint32_t numberOfBins, uint32_t amplitudeNormalisingConstant);
+
+void NoiseFloor_update(float *fftBuffer);
+
+void NoiseFloor_calculate(noiseFloorState_t *state);
+
+float NoiseFloor_getPower(noiseFloorState_t *state, uint32_t bin);
+
+void NoiseFloor_calculateSNR(noiseFloorState_t *state, float *powerBuffer, float *snrBuffer, uint32_t length);
+
+#endif /* __NOISEFLOOR_H */
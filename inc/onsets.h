@@ -0,0 +1,54 @@
+/****************************************************************************
+ * onsets.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __ONSETS_H
+#define __ONSETS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Onset constants */
+
+#define ONSETS_MAXIMUM_NUMBER                   8
+
+#define ONSETS_NUMBER_OF_BANDS                  16
+
+#define ONSETS_THRESHOLD_DEVIATIONS             3.0f
+#define ONSETS_MINIMUM_FLUX                     20.0f
+#define ONSETS_MINIMUM_GAP                      3
+#define ONSETS_SMOOTHING                        0.1f
+
+#define ONSETS_LEVEL_FLOOR                      -126
+#define ONSETS_STEPS_PER_DECIBEL                2
+
+/* Onsets found in one record in order of frame. Each level is a uint8 where dB = floor + level / steps. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    float flux;
+    uint16_t frame;
+    uint16_t reserved;
+    uint8_t levels[ONSETS_NUMBER_OF_BANDS];
+} onset_t;
+
+typedef struct {
+    onset_t onsets[ONSETS_MAXIMUM_NUMBER];
+    uint16_t numberOfOnsets;
+    uint16_t numberDetected;
+} onsets_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+void Onsets_initialise(uint32_t numberOfBins, uint32_t amplitudeNormalisingConstant);
+
+bool Onsets_update(float *fftBuffer);
+
+void Onsets_calculate(onsets_t *onsets);
+
+#endif /* __ONSETS_H */
@@ -0,0 +1,43 @@
+/****************************************************************************
+ * peaks.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __PEAKS_H
+#define __PEAKS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Peak constants */
+
+#define PEAKS_MAXIMUM_NUMBER                    8
+
+#define PEAKS_FLOOR_HALF_WIDTH                  16
+#define PEAKS_FLOOR_GUARD                       2
+#define PEAKS_THRESHOLD                         10
+
+/* Spectral peaks for one record in order of decreasing level. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    float frequency;
+    float level;
+    float bandwidth;
+} peak_t;
+
+typedef struct {
+    peak_t peaks[PEAKS_MAXIMUM_NUMBER];
+    uint16_t numberOfPeaks;
+    uint16_t reserved;
+} peaks_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+void Peaks_find(float *powerBuffer, uint32_t numberOfBins, float binWidth, peaks_t *peaks);
+
+#endif /* __PEAKS_H */
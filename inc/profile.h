@@ -0,0 +1,77 @@
+/****************************************************************************
+ * profile.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __PROFILE_H
+#define __PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Profile constants */
+
+#define PROFILE_VERSION                         1
+#define PROFILE_FILENAME                        "PROFILE.TLM"
+
+#define PROFILE_RING_SIZE                       12
+#define PROFILE_RECORD_INTERVAL                 10
+
+/* Phases are marked when they end. A boot mark before each initialisation mark holds the BURTC count at boot, so initialisation does not include the power down before it */
+
+typedef enum {PROFILE_PHASE_INITIALISE, PROFILE_PHASE_WAIT, PROFILE_PHASE_SETTLE, PROFILE_PHASE_ACQUISITION, PROFILE_PHASE_FILE_SYSTEM, PROFILE_PHASE_WRITE, PROFILE_NUMBER_OF_PHASES} PROFILE_phase_t;
+
+#define PROFILE_BOOT_MARK                       PROFILE_NUMBER_OF_PHASES
+
+/* Marks in the ring. The structures only hold whole words so they can live in the backup domain */
+
+typedef struct {
+    uint32_t phase;
+    uint32_t clockDivider;
+    uint32_t cycles;
+    uint32_t ticks;
+} profileMark_t;
+
+typedef struct {
+    uint32_t numberOfMarks;
+    uint32_t numberOfCycles;
+    uint32_t ticksAtReset;
+    profileMark_t marks[PROFILE_RING_SIZE];
+} profileState_t;
+
+/* Telemetry record appended to the log. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint16_t version;
+    uint16_t size;
+    uint32_t time;
+    uint16_t supplyVoltage;
+    int16_t temperature;
+    uint32_t numberOfMarks;
+    uint32_t processingCycles;
+    uint32_t ticks[PROFILE_NUMBER_OF_PHASES];
+    uint32_t cycles[PROFILE_NUMBER_OF_PHASES];
+    uint8_t clockDividers[PROFILE_NUMBER_OF_PHASES];
+    uint16_t crc;
+} profileRecord_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+void Profile_start(void);
+
+uint32_t Profile_getCycleCount(void);
+
+void Profile_reset(profileState_t *state);
+
+void Profile_mark(profileState_t *state, PROFILE_phase_t phase);
+
+void Profile_endCycle(profileState_t *state);
+
+bool Profile_appendRecord(profileState_t *state, uint32_t time, uint32_t processingCycles);
+
+#endif /* __PROFILE_H */
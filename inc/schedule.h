@@ -0,0 +1,40 @@
+/****************************************************************************
+ * schedule.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __SCHEDULE_H
+#define __SCHEDULE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "config.h"
+
+/* Schedule constants */
+
+#define SCHEDULE_MAXIMUM_PERIODS                (2 * CONFIG_MAXIMUM_SCHEDULE_WINDOWS)
+#define SCHEDULE_MAXIMUM_DAYS_TO_SEARCH         400
+
+/* Recording periods which overlap one day, in one slot for each window on the day before and the day itself. Empty slots end at zero. The structure only holds whole words so it can live in the backup domain */
+
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+    uint32_t sampleInterval;
+} schedulePeriod_t;
+
+typedef struct {
+    uint32_t day;
+    uint32_t nextSampleMode;
+    schedulePeriod_t periods[SCHEDULE_MAXIMUM_PERIODS];
+} scheduleState_t;
+
+/* Public functions */
+
+void Schedule_reset(scheduleState_t *state);
+
+bool Schedule_getNextSampleTime(configSettings_t *settings, scheduleState_t *state, uint32_t currentTime, uint32_t *nextSampleTime);
+
+#endif /* __SCHEDULE_H */
@@ -0,0 +1,63 @@
+/****************************************************************************
+ * snippet.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __SNIPPET_H
+#define __SNIPPET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Snippet constants */
+
+#define SNIPPET_PRE_TRIGGER_MILLISECONDS        2000
+#define SNIPPET_POST_TRIGGER_MILLISECONDS       1000
+
+#define SNIPPET_WRITE_SIZE                      32768
+#define SNIPPET_HEADER_SIZE                     512
+
+/* WAV header padded with a JUNK chunk so the samples start on a sector boundary. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    char id[4];
+    uint32_t size;
+} snippetChunk_t;
+
+typedef struct {
+    snippetChunk_t riff;
+    char format[4];
+    snippetChunk_t fmt;
+    uint16_t audioFormat;
+    uint16_t numberOfChannels;
+    uint32_t samplesPerSecond;
+    uint32_t bytesPerSecond;
+    uint16_t bytesPerCapture;
+    uint16_t bitsPerSample;
+    snippetChunk_t junk;
+    uint8_t padding[SNIPPET_HEADER_SIZE - 52];
+    snippetChunk_t data;
+} snippetHeader_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+bool Snippet_initialise(int16_t *ring, uint32_t ringSize, uint32_t samplesPerBuffer, uint32_t sampleRate);
+
+void Snippet_addBuffer(int16_t *samples);
+
+void Snippet_trigger(uint32_t bufferNumber);
+
+bool Snippet_isTriggered(void);
+
+bool Snippet_isCapturing(void);
+
+uint32_t Snippet_getFirstSample(void);
+
+bool Snippet_write(char *filename);
+
+#endif /* __SNIPPET_H */
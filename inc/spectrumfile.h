@@ -0,0 +1,111 @@
+/****************************************************************************
+ * spectrumfile.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __SPECTRUMFILE_H
+#define __SPECTRUMFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* File format constants */
+
+#define SF_MAGIC                                "FFTM"
+#define SF_VERSION                              1
+
+#define SF_HEADER_SIZE                          512
+#define SF_INDEX_ENTRIES                        104
+#define SF_INDEX_INTERVAL                       3600
+#define SF_INDEX_UNSET                          UINT32_MAX
+
+/* Record contents */
+
+#define SF_CONTENTS_POWER_SPECTRUM              0x0001
+#define SF_CONTENTS_AMPLITUDE_AVERAGED          0x0002
+#define SF_CONTENTS_ACOUSTIC_INDICES            0x0004
+#define SF_CONTENTS_SPECTRAL_STATISTICS         0x0008
+#define SF_CONTENTS_SPECTRAL_PEAKS              0x0010
+#define SF_CONTENTS_NOISE_FLOOR                 0x0020
+#define SF_CONTENTS_ONSETS                      0x0040
+#define SF_CONTENTS_MEL_FEATURES                0x0080
+#define SF_CONTENTS_CLASSIFICATION              0x0100
+#define SF_CONTENTS_SOUND_LEVELS                0x0200
+#define SF_CONTENTS_TRIGGER                     0x0400
+
+/* Record flags */
+
+#define SF_FLAG_VALID                           0x0001
+#define SF_FLAG_DELAYED                         0x0002
+
+/* Results of appending a record. A file which cannot take the record is left unchanged */
+
+typedef enum {SF_APPEND_SUCCESS, SF_APPEND_ERROR, SF_APPEND_INCOMPATIBLE} SF_appendResult_t;
+
+/* Window types */
+
+typedef enum {SF_WINDOW_RECTANGULAR, SF_WINDOW_HANN, SF_WINDOW_DPSS} SF_window_t;
+
+/* File header and record header. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t recordSize;
+    uint32_t contents;
+    uint16_t fftLength;
+    uint16_t numberOfBins;
+    uint32_t sampleRate;
+    uint32_t sampleInterval;
+    uint16_t buffersPerRecord;
+    uint16_t oversampleRate;
+    uint16_t clockDivider;
+    uint16_t acquisitionCycles;
+    uint8_t gainRange;
+    uint8_t gain;
+    uint8_t window;
+    uint8_t reserved0;
+    uint32_t baseTime;
+    uint8_t firmwareVersion[3];
+    uint8_t reserved1;
+    uint8_t firmwareDescription[32];
+    uint8_t deviceID[8];
+    uint32_t indexInterval;
+    uint32_t indexEntries;
+    uint32_t index[SF_INDEX_ENTRIES];
+} SF_header_t;
+
+typedef struct {
+    uint32_t time;
+    uint16_t flags;
+    uint16_t crc;
+} SF_recordHeader_t;
+
+#pragma pack(pop)
+
+/* Record payloads are written as a list of sections in the order of their contents bits */
+
+typedef struct {
+    void *data;
+    uint32_t size;
+} SF_section_t;
+
+/* Useful macros */
+
+#define SF_INDEX_BASE_TIME(time)                ((time) - (time) % SF_INDEX_INTERVAL)
+
+#define SF_IS_WITHIN_INDEX(firstTime, time)     ((time) - SF_INDEX_BASE_TIME(firstTime) < SF_INDEX_ENTRIES * SF_INDEX_INTERVAL)
+
+/* Public functions */
+
+void SpectrumFile_initialiseHeader(SF_header_t *header, uint32_t contents, uint32_t payloadSize);
+
+uint16_t SpectrumFile_calculateRecordCRC(SF_recordHeader_t *recordHeader, SF_section_t *sections, uint32_t numberOfSections);
+
+SF_appendResult_t SpectrumFile_appendRecord(char *filename, SF_header_t *header, uint32_t time, uint16_t flags, SF_section_t *sections, uint32_t numberOfSections);
+
+#endif /* __SPECTRUMFILE_H */
@@ -0,0 +1,59 @@
+/****************************************************************************
+ * statistics.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __STATISTICS_H
+#define __STATISTICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Statistics constants */
+
+#define STATISTICS_MAXIMUM_NUMBER_OF_BINS       513
+
+#define STATISTICS_LEVEL_FLOOR                  -126
+#define STATISTICS_STEPS_PER_DECIBEL            2
+
+#define STATISTICS_LEVELS_PER_BUCKET            4
+#define STATISTICS_NUMBER_OF_BUCKETS            ((UINT8_MAX + 1) / STATISTICS_LEVELS_PER_BUCKET)
+
+/* Spectral statistics for one record. Each level is a uint8 where dB = floor + level / steps. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint8_t minimum[STATISTICS_MAXIMUM_NUMBER_OF_BINS];
+    uint8_t l90[STATISTICS_MAXIMUM_NUMBER_OF_BINS];
+    uint8_t l50[STATISTICS_MAXIMUM_NUMBER_OF_BINS];
+    uint8_t l10[STATISTICS_MAXIMUM_NUMBER_OF_BINS];
+    uint8_t maximum[STATISTICS_MAXIMUM_NUMBER_OF_BINS];
+    uint8_t mean[STATISTICS_MAXIMUM_NUMBER_OF_BINS];
+    uint16_t numberOfFrames;
+} statistics_t;
+
+#pragma pack(pop)
+
+/* Working state. This is too large for the internal RAM and is placed in the external SRAM */
+
+typedef struct {
+    uint16_t histograms[STATISTICS_MAXIMUM_NUMBER_OF_BINS][STATISTICS_NUMBER_OF_BUCKETS];
+    float powerSum[STATISTICS_MAXIMUM_NUMBER_OF_BINS];
+    uint32_t numberOfBins;
+    uint32_t numberOfFrames;
+    float levelScale;
+    float levelOffset;
+    statistics_t statistics;
+} statisticsState_t;
+
+/* Public functions */
+
+void Statistics_initialise(statisticsState_t *state, uint32_t fftLength, uint32_t amplitudeNormalisingConstant);
+
+void Statistics_update(statisticsState_t *state, float *fftBuffer);
+
+void Statistics_calculate(statisticsState_t *state);
+
+#endif /* __STATISTICS_H */
@@ -0,0 +1,63 @@
+/****************************************************************************
+ * trace.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __TRACE_H
+#define __TRACE_H
+
+#include <stdint.h>
+
+/* Tracing is only compiled in when the build sets TRACE_ENABLED */
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED                           0
+#endif
+
+/* Each event is written to the ITM stimulus port of the same number as a 32-bit payload. Port 0 carries printf */
+
+#define TRACE_EVENT_DMA_TRANSFER                1
+#define TRACE_EVENT_FFT_START                   2
+#define TRACE_EVENT_FFT_END                     3
+#define TRACE_EVENT_POWER_START                 4
+#define TRACE_EVENT_POWER_END                   5
+#define TRACE_EVENT_DISK_WRITE_START            6
+#define TRACE_EVENT_DISK_WRITE_END              7
+
+#define TRACE_NUMBER_OF_EVENTS                  8
+
+/* Start events are even and are followed by the end event with the next number */
+
+#define TRACE_IS_START_EVENT(event)             ((event) > TRACE_EVENT_DMA_TRANSFER && (event) % 2 == 0)
+
+/* Trace macros */
+
+#if TRACE_ENABLED
+
+#include "em_device.h"
+
+#define TRACE_ENABLE() { \
+    Trace_enable(); \
+}
+
+#define TRACE_EVENT(event, payload) { \
+    if (ITM->TER & (1UL << (event))) { \
+        while (ITM->PORT[event].u32 == 0) { }; \
+        ITM->PORT[event].u32 = (uint32_t)(payload); \
+    } \
+}
+
+#else
+
+#define TRACE_ENABLE()
+
+#define TRACE_EVENT(event, payload)
+
+#endif
+
+/* Public functions */
+
+void Trace_enable(void);
+
+#endif /* __TRACE_H */
@@ -0,0 +1,50 @@
+/****************************************************************************
+ * trigger.h
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#ifndef __TRIGGER_H
+#define __TRIGGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Trigger constants */
+
+#define TRIGGER_THRESHOLD                       6.0f
+#define TRIGGER_MINIMUM_LEVEL                   -80.0f
+#define TRIGGER_BACKGROUND_SHIFT                5
+#define TRIGGER_WARM_UP_BUFFERS                 4
+
+/* Counts of the buffers of one high-rate acquisition and how they were handled. Levels are the mean magnitude of the sample differences in dB relative to full scale. All fields are little-endian */
+
+#pragma pack(push, 1)
+
+typedef struct {
+    float backgroundLevel;
+    float maximumLevel;
+    uint32_t cyclesPerFrame;
+    uint16_t numberOfBuffers;
+    uint16_t triggeredFrames;
+    uint16_t analysedFrames;
+    uint16_t skippedFrames;
+    uint16_t droppedFrames;
+    uint16_t reserved;
+} trigger_t;
+
+#pragma pack(pop)
+
+/* Public functions */
+
+void Trigger_initialise(uint32_t numberOfSamples, uint32_t amplitudeNormalisingConstant);
+
+bool Trigger_update(int16_t *samples);
+
+void Trigger_skipFrame(void);
+
+void Trigger_dropFrame(void);
+
+void Trigger_calculate(trigger_t *trigger, uint32_t analysedFrames, uint32_t processingCycles);
+
+#endif /* __TRIGGER_H */
@@ -6,6 +6,7 @@
 
 #include <time.h>
 #include <stdio.h>
+#include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -31,10 +32,12 @@
 #include "em_usart.h"
 
 #include "ff.h"
+#include "crc.h"
 #include "diskio.h"
 #include "dmactrl.h"
 #include "microsd.h"
 
+#include "trace.h"
 #include "pinouts.h"
 #include "usbconfig.h"
 #include "usbcallbacks.h"
@@ -125,8 +128,6 @@
 
 /* USB HID bootloader constants */
 
-#define FIRMWARE_CRC_POLY                         0x1021
-
 #define AM_FIRMWARE_START_ADDRESS                 (16 * 1024)
 #define AM_FIRMWARE_PAGE_SIZE                     (2 * 1024)
 #define AM_FIRMWARE_TOTAL_SIZE                    ((256 * 1024) - AM_FIRMWARE_START_ADDRESS)
@@ -181,6 +182,9 @@ static FATFS fatfs;
 static FIL file;
 static UINT bw;
 
+static DIR directory;
+static FILINFO fileInfo;
+
 /* DMA variables */
 
 static DMA_CB_TypeDef cb;
@@ -558,6 +562,8 @@ static void transferComplete(unsigned int channel, bool isPrimaryBuffer, void *u
 
     int16_t *nextBuffer = NULL;
 
+    TRACE_EVENT(TRACE_EVENT_DMA_TRANSFER, isPrimaryBuffer)
+
     AudioMoth_handleDirectMemoryAccessInterrupt(isPrimaryBuffer, &nextBuffer);
 
     /* Re-activate the DMA */
@@ -1347,22 +1353,6 @@ int setupCmd(const USB_Setup_TypeDef *setup) {
 
 }
 
-/* CRC update function */
-
-static inline uint16_t updateCRC(uint16_t crc, uint32_t incr) {
-
-    uint16_t xor = crc >> 15;
-
-    uint16_t out = crc << 1;
-
-    if (incr) out++;
-
-    if (xor) out ^= FIRMWARE_CRC_POLY;
-
-    return out;
-
-}
-
 /* Function held in SRAM to clear user flash page */
 
 SL_RAMFUNC_DEFINITION_BEGIN
@@ -1812,17 +1802,7 @@ void AudioMoth_handleUSB(void) {
 
         if (shouldCalculateCRC) {
 
-            currentCRC = 0;
-            
-            for (uint32_t i = 0; i < AM_FIRMWARE_TOTAL_SIZE; i += 1) {
-
-                uint32_t byte = firmwareStartAddress[i];
-
-                for (uint32_t j = 0x80; j > 0; j >>= 1) currentCRC = updateCRC(currentCRC, byte & j);
-
-            }
-
-            for (uint32_t j = 0; j < 16; j += 1) currentCRC = updateCRC(currentCRC, 0);
+            currentCRC = CRC_update(0, (const uint8_t*)firmwareStartAddress, AM_FIRMWARE_TOTAL_SIZE);
 
             completedCalculateCRC = true;
 
@@ -1830,6 +1810,10 @@ void AudioMoth_handleUSB(void) {
 
         }
 
+        /* Allow the application to do work while in USB */
+
+        AudioMoth_usbApplicationLoop();
+
         /* Handle BURTC overflow */
 
         AudioMoth_checkAndHandleTimeOverflow();
@@ -2727,6 +2711,53 @@ bool AudioMoth_doesFileExist(char *filename){
 
 }
 
+bool AudioMoth_findFile(char *extension, uint32_t index, char *filename, uint32_t maximumLength, uint32_t *fileSize) {
+
+    /* Find the file with the given index amongst the files in the root directory with the extension */
+
+    FRESULT res = f_opendir(&directory, "/");
+
+    if (res != FR_OK) {
+        return false;
+    }
+
+    uint32_t extensionLength = strlen(extension);
+
+    while (true) {
+
+        res = f_readdir(&directory, &fileInfo);
+
+        if (res != FR_OK || fileInfo.fname[0] == 0) break;
+
+        if (fileInfo.fattrib & (AM_DIR | AM_HID | AM_SYS)) continue;
+
+        uint32_t length = strlen(fileInfo.fname);
+
+        if (length < extensionLength || strcmp(fileInfo.fname + length - extensionLength, extension) != 0) continue;
+
+        if (index > 0) {
+            index -= 1;
+            continue;
+        }
+
+        f_closedir(&directory);
+
+        if (length >= maximumLength) return false;
+
+        strcpy(filename, fileInfo.fname);
+
+        *fileSize = fileInfo.fsize;
+
+        return true;
+
+    }
+
+    f_closedir(&directory);
+
+    return false;
+
+}
+
 bool AudioMoth_openFile(char *filename) {
 
     /* Open a file for writing. Overwrite existing file with the same name */
@@ -2798,6 +2829,12 @@ bool AudioMoth_seekInFile(uint32_t position) {
 
 }
 
+uint32_t AudioMoth_getFileSize(void) {
+
+    return f_size(&file);
+
+}
+
 bool AudioMoth_writeToFile(void *bytes, uint16_t bytesToWrite) {
 
     FRESULT res = f_write(&file, bytes, bytesToWrite, &bw);
@@ -0,0 +1,240 @@
+/****************************************************************************
+ * classifier.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "classifier.h"
+
+/* The Cortex-M4 has two 16-bit multiply-accumulates per instruction. Other builds use plain C */
+
+#if defined(__ARM_FEATURE_DSP)
+#include "em_device.h"
+#define USE_SIMD                                true
+#else
+#define USE_SIMD                                false
+#endif
+
+/* Useful constants */
+
+#define BYTES_IN_WORD                           4
+#define BITS_IN_BYTE                            8
+
+#define MAXIMUM_ACTIVATION                      127
+
+/* Useful macros */
+
+#define ROUND_UP_TO_WORD(x)                     (((x) + BYTES_IN_WORD - 1) & ~(BYTES_IN_WORD - 1))
+
+/* Layers of the current model */
+
+static const classifierHeader_t *header;
+
+static const classifierLayer_t *layers[CLASSIFIER_MAXIMUM_NUMBER_OF_LAYERS];
+
+static const int32_t *biases[CLASSIFIER_MAXIMUM_NUMBER_OF_LAYERS];
+
+static const int8_t *weights[CLASSIFIER_MAXIMUM_NUMBER_OF_LAYERS];
+
+static float outputScales[CLASSIFIER_MAXIMUM_NUMBER_OF_LAYERS];
+
+/* Activations of the current and next layer. Each holds a whole number of words */
+
+static int8_t activations[2][CLASSIFIER_MAXIMUM_WIDTH] __attribute__ ((aligned(4)));
+
+/* Classifier output over the frames of a record */
+
+static uint32_t numberOfFrames;
+
+static uint32_t positiveFrames;
+
+static float probabilitySum;
+
+static float maximumProbability;
+
+/* Private functions */
+
+static inline int8_t quantise(float value) {
+
+    value = value < 0.0f ? value - 0.5f : value + 0.5f;
+
+    return value < -MAXIMUM_ACTIVATION ? -MAXIMUM_ACTIVATION : value > MAXIMUM_ACTIVATION ? MAXIMUM_ACTIVATION : (int8_t)value;
+
+}
+
+static inline int32_t dotProduct(const int8_t *row, const int8_t *input, uint32_t length) {
+
+    int32_t sum = 0;
+
+#if USE_SIMD
+
+    /* Each word of four int8 values is split into its even and odd bytes as two pairs of int16 */
+
+    const uint32_t *rowWords = (const uint32_t*)row;
+
+    const uint32_t *inputWords = (const uint32_t*)input;
+
+    for (uint32_t i = 0; i < length / BYTES_IN_WORD; i += 1) {
+
+        uint32_t rowWord = rowWords[i], inputWord = inputWords[i];
+
+        sum = __SMLAD(__SXTB16(rowWord), __SXTB16(inputWord), sum);
+
+        sum = __SMLAD(__SXTB16(__ROR(rowWord, BITS_IN_BYTE)), __SXTB16(__ROR(inputWord, BITS_IN_BYTE)), sum);
+
+    }
+
+#else
+
+    for (uint32_t i = 0; i < length; i += 1) sum += (int32_t)row[i] * (int32_t)input[i];
+
+#endif
+
+    return sum;
+
+}
+
+/* Public functions */
+
+bool Classifier_initialise(const void *model, uint32_t numberOfInputs) {
+
+    header = NULL;
+
+    numberOfFrames = 0;
+
+    positiveFrames = 0;
+
+    probabilitySum = 0.0f;
+
+    maximumProbability = 0.0f;
+
+    /* Check the model before any of it is used */
+
+    const classifierHeader_t *candidate = (const classifierHeader_t*)model;
+
+    if ((uintptr_t)model % BYTES_IN_WORD != 0) return false;
+
+    if (memcmp(candidate->magic, CLASSIFIER_MAGIC, sizeof(candidate->magic)) != 0 || candidate->version != CLASSIFIER_VERSION) return false;
+
+    if (candidate->numberOfLayers == 0 || candidate->numberOfLayers > CLASSIFIER_MAXIMUM_NUMBER_OF_LAYERS || candidate->numberOfInputs != numberOfInputs) return false;
+
+    const uint8_t *position = (const uint8_t*)model + sizeof(classifierHeader_t);
+
+    uint32_t layerInputs = numberOfInputs;
+
+    for (uint32_t i = 0; i < candidate->numberOfLayers; i += 1) {
+
+        const classifierLayer_t *layer = (const classifierLayer_t*)position;
+
+        if (layer->numberOfInputs != layerInputs || layer->numberOfOutputs == 0 || layer->numberOfOutputs > CLASSIFIER_MAXIMUM_WIDTH) return false;
+
+        if (layer->rowLength != ROUND_UP_TO_WORD(layer->numberOfInputs) || layer->inputScale <= 0.0f || layer->weightScale <= 0.0f) return false;
+
+        layers[i] = layer;
+
+        biases[i] = (const int32_t*)(position + sizeof(classifierLayer_t));
+
+        weights[i] = (const int8_t*)(biases[i] + layer->numberOfOutputs);
+
+        outputScales[i] = layer->inputScale * layer->weightScale;
+
+        position = (const uint8_t*)weights[i] + layer->numberOfOutputs * layer->rowLength;
+
+        layerInputs = layer->numberOfOutputs;
+
+    }
+
+    if (layerInputs != 1 || position - (const uint8_t*)model != candidate->size) return false;
+
+    header = candidate;
+
+    return true;
+
+}
+
+float Classifier_predict(float *inputs) {
+
+    if (header == NULL) return 0.0f;
+
+    /* The first layer scale also quantises the inputs. Padding stays at zero so it adds nothing to the dot products */
+
+    const classifierLayer_t *layer = layers[0];
+
+    int8_t *input = activations[0];
+
+    for (uint32_t i = 0; i < layer->rowLength; i += 1) input[i] = i < layer->numberOfInputs ? quantise((inputs[i] - header->inputOffset) / layer->inputScale) : 0;
+
+    float output = 0.0f;
+
+    for (uint32_t l = 0; l < header->numberOfLayers; l += 1) {
+
+        layer = layers[l];
+
+        input = activations[l % 2];
+
+        int8_t *next = activations[(l + 1) % 2];
+
+        bool isLast = l == header->numberOfLayers - 1;
+
+        float nextScale = isLast ? 1.0f : outputScales[l] / layers[l + 1]->inputScale;
+
+        for (uint32_t o = 0; o < layer->numberOfOutputs; o += 1) {
+
+            int32_t sum = biases[l][o] + dotProduct(weights[l] + o * layer->rowLength, input, layer->rowLength);
+
+            if (layer->activation == CLASSIFIER_ACTIVATION_RELU && sum < 0) sum = 0;
+
+            if (isLast) {
+
+                output = (float)sum * outputScales[l];
+
+            } else {
+
+                next[o] = quantise((float)sum * nextScale);
+
+            }
+
+        }
+
+        if (!isLast) memset(next + layer->numberOfOutputs, 0, layers[l + 1]->rowLength - layer->numberOfOutputs);
+
+    }
+
+    return layer->activation == CLASSIFIER_ACTIVATION_LOGISTIC ? 1.0f / (1.0f + expf(-output)) : output;
+
+}
+
+bool Classifier_update(float *inputs) {
+
+    float probability = Classifier_predict(inputs);
+
+    bool isPositive = probability > CLASSIFIER_THRESHOLD;
+
+    if (probability > maximumProbability) maximumProbability = probability;
+
+    if (isPositive) positiveFrames += 1;
+
+    probabilitySum += probability;
+
+    numberOfFrames += 1;
+
+    return isPositive;
+
+}
+
+void Classifier_calculate(classification_t *classification, uint32_t inferenceCycles) {
+
+    classification->maximumProbability = maximumProbability;
+
+    classification->meanProbability = numberOfFrames > 0 ? probabilitySum / (float)numberOfFrames : 0.0f;
+
+    classification->cyclesPerInference = numberOfFrames > 0 ? inferenceCycles / numberOfFrames : 0;
+
+    classification->positiveFrames = positiveFrames;
+
+    classification->numberOfFrames = numberOfFrames;
+
+}
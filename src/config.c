@@ -0,0 +1,184 @@
+/****************************************************************************
+ * config.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "crc.h"
+#include "config.h"
+#include "audiomoth.h"
+
+/* Limits on the settings */
+
+#define MINIMUM_SAMPLE_INTERVAL                 2
+#define MAXIMUM_SAMPLE_INTERVAL                 86400
+
+#define MINIMUM_SAMPLE_RATE                     8000
+#define MAXIMUM_SAMPLE_RATE                     384000
+
+#define MAXIMUM_OVERSAMPLE_RATE                 128
+#define MAXIMUM_CLOCK_DIVIDER                   8
+#define MAXIMUM_ACQUISITION_CYCLES              16
+
+#define MAXIMUM_LATITUDE                        90000000
+#define MAXIMUM_LONGITUDE                       180000000
+
+#define MAXIMUM_LEVEL_CALIBRATION               20000
+
+#define MINUTES_IN_DAY                          1440
+#define MAXIMUM_RELATIVE_MINUTES                720
+#define MAXIMUM_SUNRISE_EVENT                   3
+
+/* The ADC runs from the 12 MHz peripheral clock and a 12-bit conversion takes 13 cycles after acquisition */
+
+#define ADC_CLOCK_FREQUENCY                     12000000
+#define ADC_CONVERSION_CYCLES                   13
+
+/* Useful macro */
+
+#define IS_POWER_OF_TWO(x)                      ((x) > 0 && ((x) & ((x) - 1)) == 0)
+
+/* Private functions */
+
+static void copyToBackupDomain(uint32_t *destination, uint8_t *source, uint32_t length) {
+
+    /* The backup domain registers only accept whole word writes */
+
+    for (uint32_t i = 0; i < length / sizeof(uint32_t); i += 1) {
+
+        uint32_t value;
+
+        memcpy(&value, source + i * sizeof(uint32_t), sizeof(uint32_t));
+
+        destination[i] = value;
+
+    }
+
+}
+
+static bool isValidInterval(configSettings_t *settings, uint32_t sampleInterval, uint32_t samplesPerBuffer) {
+
+    if (sampleInterval < MINIMUM_SAMPLE_INTERVAL || sampleInterval > MAXIMUM_SAMPLE_INTERVAL) return false;
+
+    /* The buffers must be collected within the sample interval */
+
+    uint64_t samplesToCollect = (uint64_t)settings->buffersToCollect * samplesPerBuffer;
+
+    return samplesToCollect < (uint64_t)settings->sampleRate * (sampleInterval - 1);
+
+}
+
+static bool isValidTime(uint8_t reference, int16_t minutes) {
+
+    if (reference == CONFIG_REFERENCE_ABSOLUTE) return minutes >= 0 && minutes < MINUTES_IN_DAY;
+
+    if (reference == CONFIG_REFERENCE_DAWN || reference == CONFIG_REFERENCE_DUSK) return minutes >= -MAXIMUM_RELATIVE_MINUTES && minutes <= MAXIMUM_RELATIVE_MINUTES;
+
+    return false;
+
+}
+
+static bool isValidWindow(configSettings_t *settings, scheduleWindow_t *window, uint32_t samplesPerBuffer) {
+
+    if (!isValidTime(window->startReference, window->startMinutes) || !isValidTime(window->endReference, window->endMinutes)) return false;
+
+    if (window->event > MAXIMUM_SUNRISE_EVENT || window->mode == 0) return false;
+
+    return isValidInterval(settings, window->sampleInterval, samplesPerBuffer);
+
+}
+
+/* Public functions */
+
+uint16_t Config_calculateCRC(configSettings_t *settings) {
+
+    return CRC_update(0, (uint8_t*)settings, offsetof(configSettings_t, crc));
+
+}
+
+bool Config_isValid(configSettings_t *settings, uint32_t samplesPerBuffer) {
+
+    if (settings->version != CONFIG_VERSION || settings->size != sizeof(configSettings_t)) return false;
+
+    if (settings->crc != Config_calculateCRC(settings)) return false;
+
+    if (settings->sampleRate < MINIMUM_SAMPLE_RATE || settings->sampleRate > MAXIMUM_SAMPLE_RATE) return false;
+
+    if (!IS_POWER_OF_TWO(settings->oversampleRate) || settings->oversampleRate > MAXIMUM_OVERSAMPLE_RATE) return false;
+
+    if (settings->clockDivider == 0 || settings->clockDivider > MAXIMUM_CLOCK_DIVIDER) return false;
+
+    if (!IS_POWER_OF_TWO(settings->acquisitionCycles) || settings->acquisitionCycles > MAXIMUM_ACQUISITION_CYCLES) return false;
+
+    if (settings->gainRange > AM_NORMAL_GAIN_RANGE || settings->gain > AM_GAIN_HIGH) return false;
+
+    /* The ADC must keep up with the sample rate */
+
+    uint64_t adcCycles = (uint64_t)settings->sampleRate * settings->oversampleRate * (settings->acquisitionCycles + ADC_CONVERSION_CYCLES) * settings->clockDivider;
+
+    if (adcCycles > ADC_CLOCK_FREQUENCY) return false;
+
+    /* Check the default cadence and the schedule */
+
+    if (settings->buffersToCollect == 0 || !isValidInterval(settings, settings->sampleInterval, samplesPerBuffer)) return false;
+
+    if (settings->latitude < -MAXIMUM_LATITUDE || settings->latitude > MAXIMUM_LATITUDE) return false;
+
+    if (settings->longitude < -MAXIMUM_LONGITUDE || settings->longitude > MAXIMUM_LONGITUDE) return false;
+
+    if (settings->levelCalibration < -MAXIMUM_LEVEL_CALIBRATION || settings->levelCalibration > MAXIMUM_LEVEL_CALIBRATION) return false;
+
+    if (settings->numberOfScheduleWindows > CONFIG_MAXIMUM_SCHEDULE_WINDOWS) return false;
+
+    for (uint32_t i = 0; i < settings->numberOfScheduleWindows; i += 1) {
+
+        if (!isValidWindow(settings, settings->scheduleWindows + i, samplesPerBuffer)) return false;
+
+    }
+
+    return true;
+
+}
+
+bool Config_save(configSettings_t *settings, uint32_t samplesPerBuffer) {
+
+    settings->version = CONFIG_VERSION;
+
+    settings->size = sizeof(configSettings_t);
+
+    settings->crc = Config_calculateCRC(settings);
+
+    if (!Config_isValid(settings, samplesPerBuffer)) return false;
+
+    if (!AudioMoth_writeToFlashUserDataPage((uint8_t*)settings, sizeof(configSettings_t))) return false;
+
+    return memcmp((void*)AM_FLASH_USER_DATA_ADDRESS, settings, sizeof(configSettings_t)) == 0;
+
+}
+
+void Config_load(configSettings_t *settings, const configSettings_t *defaultSettings, uint32_t samplesPerBuffer) {
+
+    /* Use the stored settings if they pass the checks and otherwise fall back to the defaults */
+
+    static configSettings_t newSettings;
+
+    configSettings_t *storedSettings = (configSettings_t*)AM_FLASH_USER_DATA_ADDRESS;
+
+    if (Config_isValid(storedSettings, samplesPerBuffer)) {
+
+        memcpy(&newSettings, storedSettings, sizeof(configSettings_t));
+
+    } else {
+
+        memcpy(&newSettings, defaultSettings, sizeof(configSettings_t));
+
+        newSettings.crc = Config_calculateCRC(&newSettings);
+
+    }
+
+    copyToBackupDomain((uint32_t*)settings, (uint8_t*)&newSettings, sizeof(configSettings_t));
+
+}
@@ -0,0 +1,401 @@
+/****************************************************************************
+ * download.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <string.h>
+
+#include "crc.h"
+#include "audiomoth.h"
+#include "download.h"
+
+/* Useful macros */
+
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+
+#define ROUNDED_DIV(a, b)                       (((a) + (b) - 1) / (b))
+
+/* Read ahead buffers shared between the main loop and the USB interrupt */
+
+static uint8_t *buffers[2];
+
+static uint32_t bufferOffset[2];
+
+static volatile uint32_t bufferLength[2];
+
+static volatile bool bufferFull[2];
+
+static uint32_t fillBuffer;
+
+static uint32_t serveBuffer;
+
+static uint32_t serveSequence;
+
+/* Message waiting to be handled by the main loop */
+
+static volatile uint8_t pendingMessage;
+
+static uint32_t pendingArgument;
+
+static char pendingFilename[DOWNLOAD_MAXIMUM_FILENAME_LENGTH];
+
+/* Reply waiting to be sent to the host */
+
+static uint8_t reply[DOWNLOAD_PACKET_SIZE];
+
+static volatile bool replyReady;
+
+/* File state, only used by the main loop */
+
+static bool fileSystemEnabled;
+
+static bool fileOpen;
+
+static bool endOfFileSent;
+
+static uint32_t fileSize;
+
+static uint32_t filePosition;
+
+static uint32_t nextOffset;
+
+static volatile bool streaming;
+
+/* Private functions */
+
+static void writeUint32(uint8_t *bytes, uint32_t value) {
+
+    memcpy(bytes, &value, sizeof(uint32_t));
+
+}
+
+static uint32_t readUint32(uint8_t *bytes) {
+
+    uint32_t value;
+
+    memcpy(&value, bytes, sizeof(uint32_t));
+
+    return value;
+
+}
+
+static void setReply(uint8_t message, uint8_t status, char *filename, uint32_t size) {
+
+    memset(reply, 0, DOWNLOAD_PACKET_SIZE);
+
+    reply[1] = status;
+
+    reply[2] = message;
+
+    writeUint32(reply + 4, size);
+
+    if (filename) strcpy((char*)reply + DOWNLOAD_FILENAME_OFFSET, filename);
+
+    replyReady = true;
+
+}
+
+static void closeFile() {
+
+    streaming = false;
+
+    if (fileOpen) AudioMoth_closeFile();
+
+    fileOpen = false;
+
+}
+
+static void startStreaming(uint32_t sequence) {
+
+    streaming = false;
+
+    bufferFull[0] = false;
+
+    bufferFull[1] = false;
+
+    fillBuffer = 0;
+
+    serveBuffer = 0;
+
+    serveSequence = sequence;
+
+    /* Reads start at the buffer boundary before the chunk, so chunks are decoupled from the sectors of the file */
+
+    uint32_t offset = MIN(sequence, ROUNDED_DIV(fileSize, DOWNLOAD_CHUNK_DATA_SIZE)) * DOWNLOAD_CHUNK_DATA_SIZE;
+
+    nextOffset = offset - offset % DOWNLOAD_BYTES_PER_BUFFER;
+
+    endOfFileSent = false;
+
+    streaming = true;
+
+}
+
+static void handleMessage(uint8_t message) {
+
+    if (!fileSystemEnabled && message != DOWNLOAD_MESSAGE_CLOSE) fileSystemEnabled = AudioMoth_enableFileSystem(AM_SD_CARD_HIGH_SPEED);
+
+    if (!fileSystemEnabled && message != DOWNLOAD_MESSAGE_CLOSE) {
+
+        setReply(message, DOWNLOAD_STATUS_ERROR, NULL, 0);
+
+        return;
+
+    }
+
+    if (message == DOWNLOAD_MESSAGE_LIST) {
+
+        char filename[DOWNLOAD_MAXIMUM_FILENAME_LENGTH];
+
+        uint32_t size;
+
+        bool success = AudioMoth_findFile(DOWNLOAD_FILE_EXTENSION, pendingArgument, filename, DOWNLOAD_MAXIMUM_FILENAME_LENGTH, &size);
+
+        setReply(message, success ? DOWNLOAD_STATUS_OK : DOWNLOAD_STATUS_ERROR, success ? filename : NULL, success ? size : 0);
+
+    } else if (message == DOWNLOAD_MESSAGE_OPEN) {
+
+        closeFile();
+
+        fileOpen = AudioMoth_openFileToRead(pendingFilename);
+
+        fileSize = fileOpen ? AudioMoth_getFileSize() : 0;
+
+        filePosition = 0;
+
+        setReply(message, fileOpen ? DOWNLOAD_STATUS_OK : DOWNLOAD_STATUS_ERROR, fileOpen ? pendingFilename : NULL, fileSize);
+
+        if (fileOpen) startStreaming(0);
+
+    } else if (message == DOWNLOAD_MESSAGE_SEEK) {
+
+        /* The host asks for a chunk again after a gap or a CRC failure */
+
+        if (fileOpen) {
+
+            startStreaming(pendingArgument);
+
+        } else {
+
+            setReply(message, DOWNLOAD_STATUS_ERROR, NULL, 0);
+
+        }
+
+    } else if (message == DOWNLOAD_MESSAGE_CLOSE) {
+
+        Download_stop();
+
+        setReply(message, DOWNLOAD_STATUS_OK, NULL, 0);
+
+    }
+
+}
+
+static void fillReadAheadBuffer() {
+
+    if (bufferFull[fillBuffer] || nextOffset >= fileSize) return;
+
+    /* Each buffer starts on a sector boundary of the file, so whole sectors are read straight into it as a multiple block read */
+
+    uint32_t offset = nextOffset;
+
+    uint32_t length = MIN(fileSize - offset, DOWNLOAD_BYTES_PER_BUFFER);
+
+    bool success = filePosition == offset || AudioMoth_seekInFile(offset);
+
+    if (success) success = AudioMoth_readFile((char*)buffers[fillBuffer], length);
+
+    if (!success) {
+
+        streaming = false;
+
+        filePosition = UINT32_MAX;
+
+        setReply(DOWNLOAD_MESSAGE_DATA, DOWNLOAD_STATUS_ERROR, NULL, offset);
+
+        return;
+
+    }
+
+    filePosition = offset + length;
+
+    bufferOffset[fillBuffer] = offset;
+
+    bufferLength[fillBuffer] = length;
+
+    bufferFull[fillBuffer] = true;
+
+    nextOffset = offset + length;
+
+    fillBuffer ^= 1;
+
+}
+
+/* Public functions */
+
+void Download_initialise(uint8_t *workspace) {
+
+    buffers[0] = workspace;
+
+    buffers[1] = workspace + DOWNLOAD_BYTES_PER_BUFFER;
+
+    pendingMessage = 0;
+
+    replyReady = false;
+
+    streaming = false;
+
+    fileOpen = false;
+
+    fileSystemEnabled = false;
+
+}
+
+void Download_loop() {
+
+    uint8_t message = pendingMessage;
+
+    if (message != 0) {
+
+        handleMessage(message);
+
+        pendingMessage = 0;
+
+    }
+
+    /* Read ahead into whichever buffer the host has finished with */
+
+    if (streaming) {
+
+        fillReadAheadBuffer();
+
+        fillReadAheadBuffer();
+
+    }
+
+}
+
+void Download_stop() {
+
+    closeFile();
+
+    if (fileSystemEnabled) AudioMoth_disableFileSystem();
+
+    fileSystemEnabled = false;
+
+    pendingMessage = 0;
+
+}
+
+void Download_packetReceived(uint8_t *receiveBuffer, uint8_t *transmitBuffer, uint32_t size) {
+
+    uint8_t message = receiveBuffer[1];
+
+    transmitBuffer[1] = message;
+
+    /* Only one message can wait for the main loop at a time */
+
+    if (pendingMessage != 0) return;
+
+    if (message == DOWNLOAD_MESSAGE_OPEN) {
+
+        memcpy(pendingFilename, receiveBuffer + 2, DOWNLOAD_MAXIMUM_FILENAME_LENGTH);
+
+        pendingFilename[DOWNLOAD_MAXIMUM_FILENAME_LENGTH - 1] = 0;
+
+    } else {
+
+        pendingArgument = readUint32(receiveBuffer + 2);
+
+    }
+
+    replyReady = false;
+
+    pendingMessage = message;
+
+    transmitBuffer[2] = true;
+
+}
+
+void Download_packetRequested(uint8_t *transmitBuffer, uint32_t size) {
+
+    if (size < DOWNLOAD_PACKET_SIZE) return;
+
+    if (replyReady) {
+
+        memcpy(transmitBuffer + 1, reply + 1, DOWNLOAD_PACKET_SIZE - 1);
+
+        replyReady = false;
+
+        return;
+
+    }
+
+    if (pendingMessage != 0 || !streaming || endOfFileSent) return;
+
+    /* A chunk with no data after the last one marks the end of the file */
+
+    uint32_t offset = serveSequence * DOWNLOAD_CHUNK_DATA_SIZE;
+
+    uint32_t length = offset < fileSize ? MIN(fileSize - offset, DOWNLOAD_CHUNK_DATA_SIZE) : 0;
+
+    uint32_t sequence = length > 0 ? serveSequence : ROUNDED_DIV(fileSize, DOWNLOAD_CHUNK_DATA_SIZE);
+
+    /* A chunk may run from the end of one buffer into the start of the other, and is only sent once both are full */
+
+    uint32_t start = 0, firstLength = 0;
+
+    if (length > 0) {
+
+        if (!bufferFull[serveBuffer]) return;
+
+        start = offset - bufferOffset[serveBuffer];
+
+        firstLength = MIN(length, bufferLength[serveBuffer] - start);
+
+        if (firstLength < length && !bufferFull[serveBuffer ^ 1]) return;
+
+    }
+
+    /* Send the next chunk with its sequence number and CRC */
+
+    transmitBuffer[1] = DOWNLOAD_STATUS_OK;
+
+    transmitBuffer[2] = DOWNLOAD_MESSAGE_DATA;
+
+    transmitBuffer[3] = length;
+
+    writeUint32(transmitBuffer + 4, sequence);
+
+    memcpy(transmitBuffer + DOWNLOAD_CHUNK_HEADER_SIZE, buffers[serveBuffer] + start, firstLength);
+
+    memcpy(transmitBuffer + DOWNLOAD_CHUNK_HEADER_SIZE + firstLength, buffers[serveBuffer ^ 1], length - firstLength);
+
+    uint16_t crc = CRC_update(0, transmitBuffer + 2, 6);
+
+    crc = CRC_update(crc, transmitBuffer + DOWNLOAD_CHUNK_HEADER_SIZE, length);
+
+    memcpy(transmitBuffer + 8, &crc, sizeof(uint16_t));
+
+    if (length == 0) {
+
+        endOfFileSent = true;
+
+        return;
+
+    }
+
+    /* Hand a buffer back to the main loop once all of its data has been sent */
+
+    serveSequence += 1;
+
+    if (start + length >= bufferLength[serveBuffer]) {
+
+        bufferFull[serveBuffer] = false;
+
+        serveBuffer ^= 1;
+
+    }
+
+}
@@ -7,14 +7,22 @@
 #include <math.h>
 #include <stdint.h>
 
+#include "trace.h"
+
+/* The transform size is set at build time by the tables */
+
+#if FFT_SIZE == 512
+#include "fft_tables_512.h"
+#else
 #include "fft_tables_1024.h"
+#endif
 
 /* Radix functions */
 
-static inline void singleRealTransform2(int16_t *dataBuffer, uint32_t index, uint32_t step, uint32_t outOffset, float *fftBuffer) {
+static inline void singleRealTransform2(int16_t *dataBuffer, const float *window, uint32_t index, uint32_t step, uint32_t outOffset, float *fftBuffer) {
 
-    const float evenR = (float)dataBuffer[index] * coefficients[index];
-    const float oddR = (float)dataBuffer[index + step] * coefficients[index + step];
+    const float evenR = (float)dataBuffer[index] * window[index];
+    const float oddR = (float)dataBuffer[index + step] * window[index + step];
 
     const float leftR = evenR + oddR;
     const float rightR = evenR - oddR;
@@ -26,12 +34,12 @@ static inline void singleRealTransform2(int16_t *dataBuffer, uint32_t index, uin
 
 }
 
-static inline void singleRealTransform4(int16_t *dataBuffer, uint32_t index, uint32_t step, uint32_t outOffset, float *fftBuffer) {
+static inline void singleRealTransform4(int16_t *dataBuffer, const float *window, uint32_t index, uint32_t step, uint32_t outOffset, float *fftBuffer) {
 
-    const float Ar = (float)dataBuffer[index] * coefficients[index];
-    const float Br = (float)dataBuffer[index + step] * coefficients[index + step];
-    const float Cr = (float)dataBuffer[index + 2 * step] * coefficients[index + 2 * step];
-    const float Dr = (float)dataBuffer[index + 3 * step] * coefficients[index + 3 * step];
+    const float Ar = (float)dataBuffer[index] * window[index];
+    const float Br = (float)dataBuffer[index + step] * window[index + step];
+    const float Cr = (float)dataBuffer[index + 2 * step] * window[index + 2 * step];
+    const float Dr = (float)dataBuffer[index + 3 * step] * window[index + 3 * step];
 
     const float T0r = Ar + Cr;
     const float T1r = Ar - Cr;
@@ -58,7 +66,9 @@ static inline void singleRealTransform4(int16_t *dataBuffer, uint32_t index, uin
 
 /* Public functions */
 
-void FFT_realTransform(int16_t *dataBuffer, float *fftBuffer) {
+void FFT_realTransformWithWindow(int16_t *dataBuffer, const float *window, float *fftBuffer) {
+
+    TRACE_EVENT(TRACE_EVENT_FFT_START, 0)
 
     /* Initialise counters */
 
@@ -72,7 +82,7 @@ void FFT_realTransform(int16_t *dataBuffer, float *fftBuffer) {
 
         for (uint32_t outputOffset = 0, t = 0; outputOffset < CSIZE; outputOffset += len, t++) {
 
-            singleRealTransform2(dataBuffer, bitReversalTable[t] >> 1, step >> 1, outputOffset, fftBuffer);
+            singleRealTransform2(dataBuffer, window, bitReversalTable[t] >> 1, step >> 1, outputOffset, fftBuffer);
 
         }
 
@@ -80,7 +90,7 @@ void FFT_realTransform(int16_t *dataBuffer, float *fftBuffer) {
 
         for (uint32_t outputOffset = 0, t = 0; outputOffset < CSIZE; outputOffset += len, t++) {
 
-            singleRealTransform4(dataBuffer, bitReversalTable[t] >> 1, step >> 1, outputOffset, fftBuffer);
+            singleRealTransform4(dataBuffer, window, bitReversalTable[t] >> 1, step >> 1, outputOffset, fftBuffer);
 
         }
 
@@ -195,6 +205,14 @@ void FFT_realTransform(int16_t *dataBuffer, float *fftBuffer) {
 
     }
 
+    TRACE_EVENT(TRACE_EVENT_FFT_END, 0)
+
+}
+
+void FFT_realTransform(int16_t *dataBuffer, float *fftBuffer) {
+
+    FFT_realTransformWithWindow(dataBuffer, coefficients, fftBuffer);
+
 }
 
 void FFT_completeSpectrum(float *fftBuffer) {
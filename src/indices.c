@@ -0,0 +1,241 @@
+/****************************************************************************
+ * indices.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "indices.h"
+
+/* Useful constants */
+
+#define MAXIMUM_NUMBER_OF_DIVERSITY_BANDS       (INDICES_DIVERSITY_MAXIMUM_FREQUENCY / INDICES_DIVERSITY_BAND_WIDTH)
+
+#define HERTZ_IN_KILOHERTZ                      1000.0f
+#define DECIBEL_FLOOR                           1e-20f
+
+/* Useful macros */
+
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+
+/* Frequency ranges as bin numbers */
+
+static uint32_t fftLength;
+
+static uint32_t sampleRate;
+
+static uint32_t numberOfBins;
+
+static uint32_t numberOfDiversityBands;
+
+static uint32_t diversityBandStart[MAXIMUM_NUMBER_OF_DIVERSITY_BANDS + 1];
+
+static uint32_t anthrophonyStart, anthrophonyEnd;
+
+static uint32_t biophonyStart, biophonyEnd;
+
+static float diversityThreshold;
+
+/* Running sums over the frames of a record */
+
+static uint32_t numberOfFrames;
+
+static float previousAmplitude[INDICES_MAXIMUM_NUMBER_OF_BINS];
+
+static float amplitudeDifferenceSum[INDICES_MAXIMUM_NUMBER_OF_BINS];
+
+static float amplitudeSum[INDICES_MAXIMUM_NUMBER_OF_BINS];
+
+static uint32_t diversityCounts[MAXIMUM_NUMBER_OF_DIVERSITY_BANDS];
+
+static float anthrophonyPower, biophonyPower;
+
+static float envelopeSum, envelopeEntropySum;
+
+/* Private functions */
+
+static uint32_t binForFrequency(uint32_t frequency) {
+
+    return MIN((uint64_t)frequency * fftLength / sampleRate, numberOfBins);
+
+}
+
+static float normalisedEntropy(float sum, float entropySum, uint32_t count) {
+
+    /* With p = x / sum the entropy is log(sum) - sum(x log x) / sum */
+
+    if (sum <= 0.0f || count < 2) return 0.0f;
+
+    return (logf(sum) - entropySum / sum) / logf((float)count);
+
+}
+
+/* Public functions */
+
+void Indices_initialise(uint32_t newSampleRate, uint32_t newFftLength, uint32_t amplitudeNormalisingConstant) {
+
+    sampleRate = newSampleRate;
+
+    fftLength = newFftLength;
+
+    numberOfBins = MIN(fftLength / 2 + 1, INDICES_MAXIMUM_NUMBER_OF_BINS);
+
+    /* Diversity bands stop at the Nyquist frequency */
+
+    numberOfDiversityBands = MIN(MAXIMUM_NUMBER_OF_DIVERSITY_BANDS, sampleRate / 2 / INDICES_DIVERSITY_BAND_WIDTH);
+
+    for (uint32_t i = 0; i <= numberOfDiversityBands; i += 1) diversityBandStart[i] = binForFrequency(i * INDICES_DIVERSITY_BAND_WIDTH);
+
+    anthrophonyStart = binForFrequency(INDICES_ANTHROPHONY_MINIMUM_FREQUENCY);
+
+    anthrophonyEnd = binForFrequency(INDICES_ANTHROPHONY_MAXIMUM_FREQUENCY);
+
+    biophonyStart = binForFrequency(INDICES_BIOPHONY_MINIMUM_FREQUENCY);
+
+    biophonyEnd = binForFrequency(INDICES_BIOPHONY_MAXIMUM_FREQUENCY);
+
+    /* A full scale sine wave has a bin amplitude of half the normalising constant */
+
+    float fullScale = (float)amplitudeNormalisingConstant / 2.0f;
+
+    diversityThreshold = fullScale * fullScale * powf(10.0f, INDICES_DIVERSITY_THRESHOLD / 10.0f);
+
+    /* Clear the running sums */
+
+    numberOfFrames = 0;
+
+    memset(amplitudeDifferenceSum, 0, sizeof(amplitudeDifferenceSum));
+
+    memset(amplitudeSum, 0, sizeof(amplitudeSum));
+
+    memset(diversityCounts, 0, sizeof(diversityCounts));
+
+    anthrophonyPower = 0.0f;
+
+    biophonyPower = 0.0f;
+
+    envelopeSum = 0.0f;
+
+    envelopeEntropySum = 0.0f;
+
+}
+
+void Indices_update(float *fftBuffer) {
+
+    float energy = 0.0f;
+
+    uint32_t band = 0;
+
+    for (uint32_t i = 0; i < numberOfBins; i += 1) {
+
+        float power = fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1];
+
+        float amplitude = sqrtf(power);
+
+        energy += power;
+
+        /* The complexity index needs the change in each bin from the previous frame */
+
+        if (numberOfFrames > 0) amplitudeDifferenceSum[i] += fabsf(amplitude - previousAmplitude[i]);
+
+        previousAmplitude[i] = amplitude;
+
+        amplitudeSum[i] += amplitude;
+
+        /* Count the cells above the threshold in each diversity band */
+
+        while (band < numberOfDiversityBands && i >= diversityBandStart[band + 1]) band += 1;
+
+        if (band < numberOfDiversityBands && power > diversityThreshold) diversityCounts[band] += 1;
+
+        if (i >= anthrophonyStart && i < anthrophonyEnd) anthrophonyPower += power;
+
+        if (i >= biophonyStart && i < biophonyEnd) biophonyPower += power;
+
+    }
+
+    /* The temporal entropy uses the frame amplitude as the envelope */
+
+    float envelope = sqrtf(energy);
+
+    envelopeSum += envelope;
+
+    if (envelope > 0.0f) envelopeEntropySum += envelope * logf(envelope);
+
+    numberOfFrames += 1;
+
+}
+
+void Indices_calculate(indices_t *indices) {
+
+    memset(indices, 0, sizeof(indices_t));
+
+    indices->numberOfFrames = numberOfFrames;
+
+    if (numberOfFrames == 0) return;
+
+    /* Complexity and spectral entropy exclude the DC bin */
+
+    float spectrumSum = 0.0f, spectrumEntropySum = 0.0f;
+
+    for (uint32_t i = 1; i < numberOfBins; i += 1) {
+
+        if (amplitudeSum[i] <= 0.0f) continue;
+
+        indices->acousticComplexity += amplitudeDifferenceSum[i] / amplitudeSum[i];
+
+        spectrumSum += amplitudeSum[i];
+
+        spectrumEntropySum += amplitudeSum[i] * logf(amplitudeSum[i]);
+
+    }
+
+    indices->spectralEntropy = normalisedEntropy(spectrumSum, spectrumEntropySum, numberOfBins - 1);
+
+    indices->temporalEntropy = normalisedEntropy(envelopeSum, envelopeEntropySum, numberOfFrames);
+
+    /* Diversity is the Shannon entropy of the fraction of cells above the threshold in each band */
+
+    float proportionSum = 0.0f, proportionEntropySum = 0.0f;
+
+    for (uint32_t i = 0; i < numberOfDiversityBands; i += 1) {
+
+        uint32_t cells = (diversityBandStart[i + 1] - diversityBandStart[i]) * numberOfFrames;
+
+        if (cells == 0 || diversityCounts[i] == 0) continue;
+
+        float proportion = (float)diversityCounts[i] / (float)cells;
+
+        proportionSum += proportion;
+
+        proportionEntropySum += proportion * logf(proportion);
+
+    }
+
+    if (proportionSum > 0.0f) indices->acousticDiversity = logf(proportionSum) - proportionEntropySum / proportionSum;
+
+    /* Bioacoustic index is the area of the mean spectrum in dB above its minimum in the biophony band */
+
+    float minimumLevel = INFINITY;
+
+    for (uint32_t i = biophonyStart; i < biophonyEnd; i += 1) {
+
+        float level = 20.0f * log10f(amplitudeSum[i] / (float)numberOfFrames + DECIBEL_FLOOR);
+
+        if (level < minimumLevel) minimumLevel = level;
+
+        indices->bioacoustic += level;
+
+    }
+
+    float binWidth = (float)sampleRate / (float)fftLength / HERTZ_IN_KILOHERTZ;
+
+    if (biophonyEnd > biophonyStart) indices->bioacoustic = (indices->bioacoustic - minimumLevel * (biophonyEnd - biophonyStart)) * binWidth;
+
+    /* Normalised difference soundscape index */
+
+    if (anthrophonyPower + biophonyPower > 0.0f) indices->normalisedDifference = (biophonyPower - anthrophonyPower) / (biophonyPower + anthrophonyPower);
+
+}
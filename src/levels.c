@@ -0,0 +1,254 @@
+/****************************************************************************
+ * levels.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "levels.h"
+#include "decibels.h"
+
+/* Useful constants */
+
+#define HANN_NOISE_BANDWIDTH                    1.5f
+
+#define WEIGHT_FRACTION_BITS                    15
+#define WEIGHT_MASK                             0xFFFF
+#define WEIGHT_BITS                             16
+
+/* IEC 61672 pole frequencies and the gains which give 0 dB at 1 kHz */
+
+#define POLE_FREQUENCY_1                        20.598997f
+#define POLE_FREQUENCY_2                        107.65265f
+#define POLE_FREQUENCY_3                        737.86223f
+#define POLE_FREQUENCY_4                        12194.217f
+
+#define A_WEIGHTING_GAIN                        2.0f
+#define C_WEIGHTING_GAIN                        0.062f
+
+/* Useful macros */
+
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                               ((a) > (b) ? (a) : (b))
+
+/* Power weights of each bin in Q15. The A weight is in the low half word and the C weight in the high half word so one load gives both */
+
+static uint32_t numberOfBins;
+
+static uint32_t fftLength;
+
+static uint32_t weights[LEVELS_MAXIMUM_NUMBER_OF_BINS];
+
+/* Conversion of the summed power to a level */
+
+static float normalisation;
+
+static float peakReference;
+
+static int32_t calibration;
+
+/* Energy and peak over the frames of a record */
+
+static uint32_t numberOfFrames;
+
+static float energySum[LEVELS_NUMBER_OF_WEIGHTINGS];
+
+static float maximumEnergy[LEVELS_NUMBER_OF_WEIGHTINGS];
+
+static int32_t maximumSample;
+
+static uint16_t histogram[LEVELS_HISTOGRAM_SIZE];
+
+/* Private functions */
+
+static float calculateWeight(float frequency, uint32_t weighting) {
+
+    /* The squared magnitude of the analogue weighting filters, kept as ratios so nothing overflows at high sample rates */
+
+    float f2 = frequency * frequency;
+
+    float lowPass = POLE_FREQUENCY_4 * POLE_FREQUENCY_4 / (f2 + POLE_FREQUENCY_4 * POLE_FREQUENCY_4);
+
+    float highPass = f2 / (f2 + POLE_FREQUENCY_1 * POLE_FREQUENCY_1);
+
+    float weight = lowPass * lowPass * highPass * highPass;
+
+    if (weighting == LEVELS_WEIGHTING_C) return weight * powf(10.0f, C_WEIGHTING_GAIN / 10.0f);
+
+    weight *= f2 / (f2 + POLE_FREQUENCY_2 * POLE_FREQUENCY_2) * f2 / (f2 + POLE_FREQUENCY_3 * POLE_FREQUENCY_3);
+
+    return weight * powf(10.0f, A_WEIGHTING_GAIN / 10.0f);
+
+}
+
+static uint32_t quantiseWeight(float weight) {
+
+    float value = weight * (float)(1 << WEIGHT_FRACTION_BITS) + 0.5f;
+
+    return value > WEIGHT_MASK ? WEIGHT_MASK : (uint32_t)value;
+
+}
+
+static float energyToLevel(float energy) {
+
+    return energy > 0.0f ? MAX(LEVELS_HISTOGRAM_FLOOR, 10.0f * log10f(energy)) : LEVELS_HISTOGRAM_FLOOR;
+
+}
+
+static float calculatePercentile(float percentile) {
+
+    /* Find the bucket holding the rank and interpolate within it */
+
+    float rank = percentile * (float)numberOfFrames;
+
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < LEVELS_HISTOGRAM_SIZE; i += 1) {
+
+        uint32_t bucketCount = histogram[i];
+
+        if (bucketCount > 0 && (float)(count + bucketCount) >= rank) {
+
+            return LEVELS_HISTOGRAM_FLOOR + ((float)i + (rank - (float)count) / (float)bucketCount) / LEVELS_HISTOGRAM_STEPS_PER_DECIBEL;
+
+        }
+
+        count += bucketCount;
+
+    }
+
+    return LEVELS_HISTOGRAM_FLOOR;
+
+}
+
+/* Public functions */
+
+void Levels_initialise(uint32_t sampleRate, uint32_t newFftLength, uint32_t amplitudeNormalisingConstant, int32_t newCalibration) {
+
+    fftLength = newFftLength;
+
+    numberOfBins = MIN(fftLength / 2 + 1, LEVELS_MAXIMUM_NUMBER_OF_BINS);
+
+    for (uint32_t i = 0; i < numberOfBins; i += 1) {
+
+        float frequency = (float)i * (float)sampleRate / (float)fftLength;
+
+        weights[i] = quantiseWeight(calculateWeight(frequency, LEVELS_WEIGHTING_A)) | quantiseWeight(calculateWeight(frequency, LEVELS_WEIGHTING_C)) << WEIGHT_BITS;
+
+    }
+
+    /* The Hann window spreads a tone over 1.5 bins of noise bandwidth, so the sum over bins is divided by it */
+
+    normalisation = Decibels_powerNormalisation(amplitudeNormalisingConstant) / HANN_NOISE_BANDWIDTH;
+
+    peakReference = (float)amplitudeNormalisingConstant / sqrtf(2.0f);
+
+    calibration = newCalibration;
+
+    numberOfFrames = 0;
+
+    maximumSample = 0;
+
+    memset(energySum, 0, sizeof(energySum));
+
+    memset(maximumEnergy, 0, sizeof(maximumEnergy));
+
+    memset(histogram, 0, sizeof(histogram));
+
+}
+
+void Levels_updatePeak(int16_t *samples) {
+
+    /* The peak is kept apart from the spectrum so every buffer can be included when only some are transformed */
+
+    int32_t maximum = maximumSample;
+
+    for (uint32_t i = 0; i < fftLength; i += 1) {
+
+        int32_t sample = samples[i] < 0 ? -(int32_t)samples[i] : samples[i];
+
+        if (sample > maximum) maximum = sample;
+
+    }
+
+    maximumSample = maximum;
+
+}
+
+void Levels_update(float *fftBuffer) {
+
+    /* Weighted sums of the bin powers. The DC bin is left out */
+
+    float energy[LEVELS_NUMBER_OF_WEIGHTINGS] = {0};
+
+    for (uint32_t i = 1; i < numberOfBins; i += 1) {
+
+        float power = fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1];
+
+        uint32_t weight = weights[i];
+
+        energy[LEVELS_WEIGHTING_Z] += power;
+
+        energy[LEVELS_WEIGHTING_A] += power * (float)(weight & WEIGHT_MASK);
+
+        energy[LEVELS_WEIGHTING_C] += power * (float)(weight >> WEIGHT_BITS);
+
+    }
+
+    energy[LEVELS_WEIGHTING_Z] *= normalisation;
+
+    energy[LEVELS_WEIGHTING_A] *= normalisation / (float)(1 << WEIGHT_FRACTION_BITS);
+
+    energy[LEVELS_WEIGHTING_C] *= normalisation / (float)(1 << WEIGHT_FRACTION_BITS);
+
+    for (uint32_t i = 0; i < LEVELS_NUMBER_OF_WEIGHTINGS; i += 1) {
+
+        energySum[i] += energy[i];
+
+        maximumEnergy[i] = MAX(maximumEnergy[i], energy[i]);
+
+    }
+
+    /* Frame levels are counted in half decibel buckets for the statistical levels */
+
+    float index = (energyToLevel(energy[LEVELS_STATISTICS_WEIGHTING]) - LEVELS_HISTOGRAM_FLOOR) * LEVELS_HISTOGRAM_STEPS_PER_DECIBEL;
+
+    uint32_t bucket = MIN((uint32_t)index, LEVELS_HISTOGRAM_SIZE - 1);
+
+    if (histogram[bucket] < UINT16_MAX) histogram[bucket] += 1;
+
+    numberOfFrames += 1;
+
+}
+
+void Levels_calculate(levels_t *levels) {
+
+    float offset = (float)calibration / LEVELS_CALIBRATION_STEPS_PER_DECIBEL;
+
+    for (uint32_t i = 0; i < LEVELS_NUMBER_OF_WEIGHTINGS; i += 1) {
+
+        levels->leq[i] = energyToLevel(numberOfFrames > 0 ? energySum[i] / (float)numberOfFrames : 0.0f) + offset;
+
+        levels->lmax[i] = energyToLevel(maximumEnergy[i]) + offset;
+
+    }
+
+    float peak = (float)maximumSample / peakReference;
+
+    levels->lpeak = energyToLevel(peak * peak) + offset;
+
+    /* L10 is the level exceeded in 10% of frames */
+
+    levels->l10 = calculatePercentile(0.9f) + offset;
+
+    levels->l50 = calculatePercentile(0.5f) + offset;
+
+    levels->l90 = calculatePercentile(0.1f) + offset;
+
+    levels->calibration = calibration;
+
+    levels->numberOfFrames = numberOfFrames;
+
+}
@@ -4,14 +4,58 @@
  * November 2024
  *****************************************************************************/
 #include <time.h>
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
 #include "fft.h"
+#include "peaks.h"
+#include "trace.h"
+#include "config.h"
+#include "levels.h"
+#include "onsets.h"
+#include "trigger.h"
+#include "indices.h"
+#include "profile.h"
+#include "download.h"
+#include "decibels.h"
+#include "mel.h"
+#include "schedule.h"
+#include "snippet.h"
+#include "classifier.h"
+#include "noisefloor.h"
+#include "multitaper.h"
 #include "audiomoth.h"
+#include "statistics.h"
+#include "spectrumfile.h"
+#include "classifier_model.h"
 #define WRITE_FILE                              true
 #define AVERAGE_FFT                             false
 #define USE_SINE_WAVE                           false
+#define RECORD_PROFILE                          true
+#define RECORD_SPECTRUM                         true
+#define RECORD_INDICES                          true
+#define RECORD_PEAKS                            true
+#define RECORD_NOISE_FLOOR                      true
+#define RECORD_ONSETS                           true
+#define RECORD_LEVELS                           true
+#define KEEP_POSITIVE_RECORDS_ONLY              false
+/* Sections which are off by default. The host check build turns them on from the command line */
+#ifndef RECORD_STATISTICS
+#define RECORD_STATISTICS                       false
+#endif
+#ifndef RECORD_MEL_FEATURES
+#define RECORD_MEL_FEATURES                     false
+#endif
+#ifndef RUN_CLASSIFIER
+#define RUN_CLASSIFIER                          false
+#endif
+#ifndef SAVE_SNIPPETS
+#define SAVE_SNIPPETS                           false
+#endif
+#ifndef USE_MULTITAPER
+#define USE_MULTITAPER                          false
+#endif
 /* DMA transfer constant */
 #define FFT_LENGTH                              1024
 #define FFT_HALF_LENGTH                         (FFT_LENGTH / 2 + 1)
@@ -22,7 +66,7 @@
 #define SECONDS_IN_HOUR                         (MINUTES_IN_HOUR * SECONDS_IN_MINUTE)
 #define YEAR_OFFSET                             1900
 #define MONTH_OFFSET                            1       
-/* Acoustic settings */
+/* Default acoustic settings used until a configuration is set over USB */
 #define ACOUSTIC_SAMPLE_INTERVAL                60
 #define NUMBER_OF_BUFFERS_TO_COLLECT            31
 #define DELAY_BEFORE_FIRST_SAMPLE               30
@@ -30,15 +74,35 @@
 #define OVERSAMPLE_RATE                         8
 #define CLOCK_DIVIDER                           1
 #define SAMPLE_RATE                             32000
+#define LEVEL_CALIBRATION                       0
 /* Sleep and LED constants */
 #define SHORT_WAIT_INTERVAL                     100
 #define DEFAULT_WAIT_INTERVAL                   1000
 #define VERY_SHORT_LED_FLASH_DURATION           1
 #define SHORT_LED_FLASH_DURATION                100
 #define LONG_LED_FLASH_DURATION                 500
-/* File constant */
+/* Long sleep constants. The RTC wakes the processor well within the watchdog period and the final second is timed with a delay */
+#define LONG_SLEEP_WAKE_UP_INTERVAL             30
+#define HEARTBEAT_INTERVAL                      10
+/* File constants */
 #define LENGTH_OF_FILENAME                      64
+#define MAXIMUM_RECORD_SECTIONS                 12
+/* Full clock sampling constant. The clock is not slowed in USB live mode, nor while sampling in high-rate and multitaper modes, so the ADC divider takes up the difference */
+#define FULL_CLOCK_DIVIDER_MULTIPLIER           4
+/* USB live mode constants */
+#define LIVE_MESSAGE_START                      0x01
+#define LIVE_MESSAGE_STOP                       0x02
+#define LIVE_MAXIMUM_FRAMES_TO_AVERAGE          UINT8_MAX
+#define LIVE_CHUNK_HEADER_SIZE                  8
+#define LIVE_CHUNK_DATA_SIZE                    56
+#define LIVE_NUMBER_OF_CHUNKS                   ((FFT_HALF_LENGTH + LIVE_CHUNK_DATA_SIZE - 1) / LIVE_CHUNK_DATA_SIZE)
+#define LIVE_DECIBEL_FLOOR                      -120
+#define LIVE_STEPS_PER_DECIBEL                  2
+/* High-rate mode constants */
+#define HIGH_RATE_MINIMUM_SAMPLE_RATE           250000
 /* Useful macros */
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                               ((a) > (b) ? (a) : (b))
 #define FLASH_LED(led, duration) { \
     AudioMoth_set ## led ## LED(true); \
     AudioMoth_delay(duration); \
@@ -53,6 +117,9 @@
         return false; \
     } \
 }
+#define PROFILE_MARK(phase) { \
+    if (RECORD_PROFILE) Profile_mark(profileState, phase); \
+}
 #define SAVE_SWITCH_POSITION_AND_POWER_DOWN(milliseconds) { \
     *previousSwitchPosition = switchPosition; \
     AudioMoth_powerDownAndWakeMilliseconds(milliseconds); \
@@ -60,12 +127,37 @@
 /* Firmware version and description */
 static uint8_t firmwareVersion[AM_FIRMWARE_VERSION_LENGTH] = {1, 0, 1};
 static uint8_t firmwareDescription[AM_FIRMWARE_DESCRIPTION_LENGTH] = "AudioMoth-FFT";
+/* Default configuration settings */
+static const configSettings_t defaultConfigSettings = {
+    .version = CONFIG_VERSION,
+    .size = sizeof(configSettings_t),
+    .sampleInterval = ACOUSTIC_SAMPLE_INTERVAL,
+    .sampleRate = SAMPLE_RATE,
+    .buffersToCollect = NUMBER_OF_BUFFERS_TO_COLLECT,
+    .oversampleRate = OVERSAMPLE_RATE,
+    .clockDivider = CLOCK_DIVIDER,
+    .acquisitionCycles = ACQUISITION_CYCLES,
+    .gainRange = AM_NORMAL_GAIN_RANGE,
+    .gain = AM_GAIN_MEDIUM,
+    .latitude = 0,
+    .longitude = 0,
+    .numberOfScheduleWindows = 0,
+    .heartbeatInterval = HEARTBEAT_INTERVAL,
+    .levelCalibration = LEVEL_CALIBRATION
+};
 /* DMA buffers */
 static int16_t primaryBuffer[FFT_LENGTH];
 static int16_t secondaryBuffer[FFT_LENGTH];
 /* FFT buffer variables */
 static int16_t *dataBuffer;
 static volatile bool dataReady;
+/* High-rate mode variables. Each buffer is numbered so the main loop can tell if the DMA has moved on from the one being transformed */
+static bool highRateMode;
+static volatile uint32_t buffersReceived;
+static volatile uint32_t dataSequence;
+/* Multitaper variables. Each buffer gives one estimate per taper, so fewer buffers are collected */
+static bool multitaperEnabled;
+static uint32_t buffersToCollect;
 static float fftBuffer[2 * FFT_LENGTH];
 #if AVERAGE_FFT
     static float meanAmplitudeBuffer[2 * FFT_HALF_LENGTH];
@@ -73,8 +165,37 @@ static float fftBuffer[2 * FFT_LENGTH];
 #else
     static float powerBuffer[FFT_HALF_LENGTH];
 #endif
+/* Soundscape indices, spectral peaks, a copy of the noise floor, the onsets, the Mel feature vectors, the classifier output, the sound levels and the trigger counts */
+static indices_t indices;
+static peaks_t peaks;
+static noiseFloorState_t noiseFloor;
+static onsets_t onsets;
+static melFeatures_t melFeatures;
+static classification_t classification;
+static levels_t levels;
+static trigger_t trigger;
 /* File name buffer */
 static char filename[LENGTH_OF_FILENAME];
+/* File header describing the acquisition settings and the record sections in the order of their contents bits */
+static SF_header_t fileHeader;
+static SF_section_t recordSections[MAXIMUM_RECORD_SECTIONS];
+static uint32_t numberOfRecordSections;
+/* Spectral statistics need the external SRAM so are left out on hardware without it */
+static bool statisticsEnabled;
+/* The classifier runs only when the model in flash matches the Mel band levels */
+static bool classifierEnabled;
+/* Snippets also need the external SRAM and share it with the spectral statistics */
+static bool snippetEnabled;
+/* USB live mode variables */
+static volatile bool liveModeRequested;
+static volatile bool liveFrameAvailable;
+static volatile uint32_t liveMinimumFramesToAverage;
+static bool liveModeRunning;
+static uint32_t liveFramesAveraged;
+static uint8_t liveFrameSequence;
+static uint8_t liveFrameDecimation;
+static uint8_t liveChunkIndex;
+static uint8_t liveFrame[LIVE_NUMBER_OF_CHUNKS * LIVE_CHUNK_DATA_SIZE];
 /* Dummy sine wave data */
 #if USE_SINE_WAVE
 const uint16_t sineTable[FFT_LENGTH] = {
@@ -144,6 +265,28 @@ const uint16_t sineTable[FFT_LENGTH] = {
 	0, -3196, -6269, -9102, -11585, -13622, -15136, -16068, -16383, -16068, -15136, -13622, -11584, -9102, -6269, -3196
 };
 #endif
+/* Backup domain layout. Each structure follows the one before, so one which grows moves the rest and the build fails if they no longer fit */
+#define CONFIG_SETTINGS_OFFSET                  16
+#define SCHEDULE_STATE_OFFSET                   (CONFIG_SETTINGS_OFFSET + sizeof(configSettings_t))
+#define PROFILE_STATE_OFFSET                    (SCHEDULE_STATE_OFFSET + sizeof(scheduleState_t))
+#define NOISE_FLOOR_STATE_OFFSET                (PROFILE_STATE_OFFSET + sizeof(profileState_t))
+#define BACKUP_DOMAIN_END                       (NOISE_FLOOR_STATE_OFFSET + sizeof(noiseFloorState_t))
+_Static_assert(BACKUP_DOMAIN_END <= AM_BACKUP_DOMAIN_SIZE_IN_BYTES, "Backup domain structures do not fit in the backup domain");
+_Static_assert(sizeof(configSettings_t) % sizeof(uint32_t) == 0, "Configuration settings must be a whole number of words");
+_Static_assert(sizeof(scheduleState_t) % sizeof(uint32_t) == 0, "Schedule state must be a whole number of words");
+_Static_assert(sizeof(profileState_t) % sizeof(uint32_t) == 0, "Profile state must be a whole number of words");
+_Static_assert(sizeof(noiseFloorState_t) % sizeof(uint32_t) == 0, "Noise floor state must be a whole number of words");
+/* Backup domain variables */
+static uint32_t *timeOfNextSample = (uint32_t*)AM_BACKUP_DOMAIN_START_ADDRESS;
+static uint32_t *timeOfFirstSample = (uint32_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + 4);
+static uint32_t *previousSwitchPosition = (uint32_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + 8);
+static uint32_t *configurationChanged = (uint32_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + 12);
+static configSettings_t *configSettings = (configSettings_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + CONFIG_SETTINGS_OFFSET);
+static scheduleState_t *scheduleState = (scheduleState_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + SCHEDULE_STATE_OFFSET);
+static profileState_t *profileState = (profileState_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + PROFILE_STATE_OFFSET);
+static noiseFloorState_t *noiseFloorState = (noiseFloorState_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + NOISE_FLOOR_STATE_OFFSET);
+/* External SRAM variables */
+static statisticsState_t *statisticsState = (statisticsState_t*)AM_EXTERNAL_SRAM_START_ADDRESS;
 /* Required time zone handler */
 void AudioMoth_timezoneRequested(int8_t *timezoneHours, int8_t *timezoneMinutes) { }
 /* Required interrupt handles */
@@ -151,11 +294,25 @@ void AudioMoth_handleMicrophoneChangeInterrupt() { }
 void AudioMoth_handleMicrophoneInterrupt(int16_t sample) { }
 void AudioMoth_handleSwitchInterrupt() { }
 inline void AudioMoth_handleDirectMemoryAccessInterrupt(bool isPrimaryBuffer, int16_t **nextBuffer) {
-    dataBuffer = secondaryBuffer;
-    if (isPrimaryBuffer) dataBuffer = primaryBuffer;
+    int16_t *buffer = secondaryBuffer;
+    if (isPrimaryBuffer) buffer = primaryBuffer;
 #if USE_SINE_WAVE
-    dataBuffer = (int16_t*)sineTable;
+    buffer = (int16_t*)sineTable;
 #endif
+    buffersReceived += 1;
+    if (snippetEnabled) Snippet_addBuffer(buffer);
+    /* In high-rate mode every buffer goes through the trigger. Triggered buffers which arrive while the main loop is still busy are skipped */
+    if (highRateMode) {
+        if (buffersReceived > buffersToCollect) return;
+        if (RECORD_LEVELS) Levels_updatePeak(buffer);
+        if (!Trigger_update(buffer)) return;
+        if (dataReady) {
+            Trigger_skipFrame();
+            return;
+        }
+    }
+    dataBuffer = buffer;
+    dataSequence = buffersReceived;
     dataReady = true;
 }
 /* Required USB message handlers */
@@ -165,28 +322,224 @@ void AudioMoth_usbFirmwareVersionRequested(uint8_t **firmwareVersionPtr) {
 void AudioMoth_usbFirmwareDescriptionRequested(uint8_t **firmwareDescriptionPtr) {
     *firmwareDescriptionPtr = firmwareDescription;
 }
-void AudioMoth_usbApplicationPacketRequested(uint32_t messageType, uint8_t *transmitBuffer, uint32_t size) { }
-void AudioMoth_usbApplicationPacketReceived(uint32_t messageType, uint8_t *receiveBuffer, uint8_t *transmitBuffer, uint32_t size) { }
-/* Backup domain variables */
-static uint32_t *timeOfNextSample = (uint32_t*)AM_BACKUP_DOMAIN_START_ADDRESS;
-static uint32_t *timeOfFirstSample = (uint32_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + 4);
-static uint32_t *previousSwitchPosition = (uint32_t*)(AM_BACKUP_DOMAIN_START_ADDRESS + 8);
-/* Function to append results */
-static bool writeDataToFile() {
+void AudioMoth_usbApplicationPacketRequested(uint32_t messageType, uint8_t *transmitBuffer, uint32_t size) {
+    if (!liveModeRequested) {
+        Download_packetRequested(transmitBuffer, size);
+        return;
+    }
+    /* Send the next chunk of the current live frame. A zero status tells the host to poll again later */
+    if (!liveFrameAvailable || size < LIVE_CHUNK_HEADER_SIZE + LIVE_CHUNK_DATA_SIZE) return;
+    transmitBuffer[1] = true;
+    transmitBuffer[2] = liveFrameSequence;
+    transmitBuffer[3] = liveChunkIndex;
+    transmitBuffer[4] = LIVE_NUMBER_OF_CHUNKS;
+    transmitBuffer[5] = liveFrameDecimation;
+    transmitBuffer[6] = (uint8_t)LIVE_DECIBEL_FLOOR;
+    transmitBuffer[7] = LIVE_STEPS_PER_DECIBEL;
+    memcpy(transmitBuffer + LIVE_CHUNK_HEADER_SIZE, liveFrame + liveChunkIndex * LIVE_CHUNK_DATA_SIZE, LIVE_CHUNK_DATA_SIZE);
+    /* Release the frame once the host has read the last chunk */
+    liveChunkIndex += 1;
+    if (liveChunkIndex == LIVE_NUMBER_OF_CHUNKS) liveFrameAvailable = false;
+}
+void AudioMoth_usbApplicationPacketReceived(uint32_t messageType, uint8_t *receiveBuffer, uint8_t *transmitBuffer, uint32_t size) {
+    /* Configuration is written to flash and applied after the next switch change */
+    if (receiveBuffer[1] == CONFIG_MESSAGE_SET || receiveBuffer[1] == CONFIG_MESSAGE_GET) {
+        transmitBuffer[1] = receiveBuffer[1];
+        /* Settings are sent in parts given by an offset and a length. The last part saves the whole structure */
+        static configSettings_t newConfigSettings;
+        uint32_t offset = receiveBuffer[2];
+        uint32_t length = receiveBuffer[1] == CONFIG_MESSAGE_SET ? receiveBuffer[3] : sizeof(configSettings_t) - offset;
+        if (length > CONFIG_MAXIMUM_PACKET_LENGTH) length = CONFIG_MAXIMUM_PACKET_LENGTH;
+        if (offset + length > sizeof(configSettings_t)) return;
+        if (receiveBuffer[1] == CONFIG_MESSAGE_SET) {
+            memcpy((uint8_t*)&newConfigSettings + offset, receiveBuffer + CONFIG_PACKET_OFFSET, length);
+            bool success = true;
+            if (offset + length == sizeof(configSettings_t)) success = Config_save(&newConfigSettings, FFT_LENGTH);
+            if (success && offset + length == sizeof(configSettings_t)) *configurationChanged = true;
+            transmitBuffer[2] = success;
+        } else {
+            uint8_t *currentConfigSettings = *configurationChanged ? (uint8_t*)AM_FLASH_USER_DATA_ADDRESS : (uint8_t*)configSettings;
+            memcpy(transmitBuffer + CONFIG_PACKET_OFFSET, currentConfigSettings + offset, length);
+            transmitBuffer[2] = true;
+            transmitBuffer[3] = length;
+        }
+        return;
+    }
+    /* Downloads and live mode share the FFT buffer so only one can run at a time */
+    if (DOWNLOAD_IS_MESSAGE(receiveBuffer[1])) {
+        liveModeRequested = false;
+        Download_packetReceived(receiveBuffer, transmitBuffer, size);
+        return;
+    }
+    transmitBuffer[1] = receiveBuffer[1];
+    if (receiveBuffer[1] == LIVE_MESSAGE_START) {
+        uint32_t minimumFramesToAverage = receiveBuffer[2];
+        if (minimumFramesToAverage == 0) minimumFramesToAverage = 1;
+        liveMinimumFramesToAverage = minimumFramesToAverage;
+        liveModeRequested = true;
+        transmitBuffer[2] = true;
+    } else if (receiveBuffer[1] == LIVE_MESSAGE_STOP) {
+        liveModeRequested = false;
+        transmitBuffer[2] = true;
+    }
+}
+/* Functions to run acquisition while in USB and stream quantised spectra to the host */
+static void startLiveMode() {
+    dataReady = false;
+    liveFrameAvailable = false;
+    liveFramesAveraged = 0;
+    AudioMoth_enableMicrophone(configSettings->gainRange, configSettings->gain, FULL_CLOCK_DIVIDER_MULTIPLIER * configSettings->clockDivider, configSettings->acquisitionCycles, configSettings->oversampleRate);
+    AudioMoth_initialiseDirectMemoryAccess(primaryBuffer, secondaryBuffer, FFT_LENGTH);
+    AudioMoth_delay(DELAY_BEFORE_FIRST_SAMPLE);
+    AudioMoth_startMicrophoneSamples(configSettings->sampleRate);
+    liveModeRunning = true;
+}
+static void stopLiveMode() {
+    AudioMoth_disableMicrophone();
+    liveFrameAvailable = false;
+    liveModeRunning = false;
+}
+static void publishLiveFrame() {
+    uint32_t amplitudeNormalisingConstant = (1 << 11) * configSettings->oversampleRate;
+    float scale = Decibels_powerNormalisation(amplitudeNormalisingConstant) / (float)liveFramesAveraged;
+    for (uint32_t i = 0; i < FFT_HALF_LENGTH; i += 1) {
+        float level = LIVE_STEPS_PER_DECIBEL * (10.0f * log10f(powerBuffer[i] * scale + 1e-20f) - LIVE_DECIBEL_FLOOR);
+        liveFrame[i] = level < 0.0f ? 0 : level > UINT8_MAX ? UINT8_MAX : (uint8_t)(level + 0.5f);
+    }
+    liveFrameDecimation = liveFramesAveraged > UINT8_MAX ? UINT8_MAX : liveFramesAveraged;
+    liveFrameSequence += 1;
+    liveChunkIndex = 0;
+    liveFramesAveraged = 0;
+    liveFrameAvailable = true;
+}
+void AudioMoth_usbApplicationLoop() {
+    if (liveModeRequested && !liveModeRunning) {
+        Download_stop();
+        startLiveMode();
+    }
+    if (!liveModeRequested && liveModeRunning) stopLiveMode();
+    if (!liveModeRequested) Download_loop();
+    if (!liveModeRunning || !dataReady) return;
+    FFT_realTransform(dataBuffer, fftBuffer);
+    dataReady = false;
+    /* Keep averaging until the host has read the last frame, so a slow host gets more heavily decimated frames */
+    for (uint32_t i = 0; i < FFT_HALF_LENGTH; i += 1) {
+        float power = fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1];
+        powerBuffer[i] = liveFramesAveraged == 0 ? power : powerBuffer[i] + power;
+    }
+    liveFramesAveraged += 1;
+    if (liveFramesAveraged < liveMinimumFramesToAverage) return;
+    if (!liveFrameAvailable) {
+        publishLiveFrame();
+    } else if (liveFramesAveraged == LIVE_MAXIMUM_FRAMES_TO_AVERAGE) {
+        /* Restart the average if the host has stopped polling */
+        liveFramesAveraged = 0;
+    }
+}
+/* Function to find the next sample time from the schedule. Samples stop if no window opens within the search limit */
+static void scheduleNextSample(uint32_t currentTime) {
+    uint32_t nextSampleTime;
+    bool success = Schedule_getNextSampleTime(configSettings, scheduleState, currentTime, &nextSampleTime);
+    *timeOfNextSample = success ? nextSampleTime : UINT32_MAX;
+}
+/* Function to sleep in EM2 until the final second before the next sample. The switch interrupt wakes the processor so a change is seen immediately */
+static bool sleepUntilNextSample(AM_switchPosition_t switchPosition) {
+    uint32_t currentTime, currentMilliseconds, timeOfNextHeartbeat = 0;
+    while (AudioMoth_getSwitchPosition() == switchPosition) {
+        AudioMoth_checkAndHandleTimeOverflow();
+        AudioMoth_getTime(&currentTime, &currentMilliseconds);
+        int64_t millisecondsUntilNextSample = (int64_t)*timeOfNextSample * MILLISECONDS_IN_SECOND - (int64_t)currentTime * MILLISECONDS_IN_SECOND - (int64_t)currentMilliseconds;
+        if (millisecondsUntilNextSample <= MILLISECONDS_IN_SECOND) return true;
+        /* Flash green LED at the configured interval */
+        if (configSettings->heartbeatInterval > 0 && currentTime >= timeOfNextHeartbeat) {
+            FLASH_LED(Green, VERY_SHORT_LED_FLASH_DURATION)
+            timeOfNextHeartbeat = currentTime + configSettings->heartbeatInterval;
+        }
+        /* Sleep until the next heartbeat, the final second or the next watchdog feed */
+        int64_t secondsToSleep = MIN(LONG_SLEEP_WAKE_UP_INTERVAL, (millisecondsUntilNextSample - MILLISECONDS_IN_SECOND) / MILLISECONDS_IN_SECOND);
+        if (configSettings->heartbeatInterval > 0) secondsToSleep = MIN(secondsToSleep, (int64_t)timeOfNextHeartbeat - (int64_t)currentTime);
+        AudioMoth_startRealTimeClock(MAX(1, secondsToSleep));
+        AudioMoth_deepSleep();
+        AudioMoth_stopRealTimeClock();
+    }
+    return false;
+}
+/* Function to add a section to the record */
+static void addRecordSection(uint32_t *contents, uint32_t *payloadSize, uint32_t contentsBit, void *data, uint32_t size) {
+    recordSections[numberOfRecordSections].data = data;
+    recordSections[numberOfRecordSections].size = size;
+    numberOfRecordSections += 1;
+    *contents |= contentsBit;
+    *payloadSize += size;
+}
+/* Function to describe the acquisition settings in the file header. The schedule window of the sample chooses which of the recorded sections are written */
+static void initialiseFileHeader() {
+    uint32_t contents = 0, payloadSize = 0, mode = scheduleState->nextSampleMode;
+    numberOfRecordSections = 0;
+    if (RECORD_SPECTRUM && (mode & CONFIG_SCHEDULE_MODE_SPECTRUM)) addRecordSection(&contents, &payloadSize, AVERAGE_FFT ? SF_CONTENTS_POWER_SPECTRUM | SF_CONTENTS_AMPLITUDE_AVERAGED : SF_CONTENTS_POWER_SPECTRUM, powerBuffer, sizeof(float) * FFT_HALF_LENGTH);
+    if (RECORD_INDICES && (mode & CONFIG_SCHEDULE_MODE_INDICES)) addRecordSection(&contents, &payloadSize, SF_CONTENTS_ACOUSTIC_INDICES, &indices, sizeof(indices_t));
+    if (statisticsEnabled && (mode & CONFIG_SCHEDULE_MODE_STATISTICS)) addRecordSection(&contents, &payloadSize, SF_CONTENTS_SPECTRAL_STATISTICS, &statisticsState->statistics, sizeof(statistics_t));
+    if (RECORD_PEAKS && (mode & CONFIG_SCHEDULE_MODE_PEAKS)) addRecordSection(&contents, &payloadSize, SF_CONTENTS_SPECTRAL_PEAKS, &peaks, sizeof(peaks_t));
+    if (RECORD_NOISE_FLOOR && (mode & CONFIG_SCHEDULE_MODE_NOISE_FLOOR)) addRecordSection(&contents, &payloadSize, SF_CONTENTS_NOISE_FLOOR, &noiseFloor, sizeof(noiseFloorState_t));
+    if (RECORD_ONSETS && (mode & CONFIG_SCHEDULE_MODE_ONSETS)) addRecordSection(&contents, &payloadSize, SF_CONTENTS_ONSETS, &onsets, sizeof(onsets_t));
+    if (RECORD_MEL_FEATURES && (mode & CONFIG_SCHEDULE_MODE_FEATURES)) addRecordSection(&contents, &payloadSize, SF_CONTENTS_MEL_FEATURES, &melFeatures, sizeof(melFeatures_t));
+    if (classifierEnabled && (mode & CONFIG_SCHEDULE_MODE_FEATURES)) addRecordSection(&contents, &payloadSize, SF_CONTENTS_CLASSIFICATION, &classification, sizeof(classification_t));
+    if (RECORD_LEVELS && (mode & CONFIG_SCHEDULE_MODE_LEVELS)) addRecordSection(&contents, &payloadSize, SF_CONTENTS_SOUND_LEVELS, &levels, sizeof(levels_t));
+    if (highRateMode) addRecordSection(&contents, &payloadSize, SF_CONTENTS_TRIGGER, &trigger, sizeof(trigger_t));
+    SpectrumFile_initialiseHeader(&fileHeader, contents, payloadSize);
+    fileHeader.fftLength = FFT_LENGTH;
+    fileHeader.numberOfBins = FFT_HALF_LENGTH;
+    fileHeader.sampleRate = configSettings->sampleRate;
+    fileHeader.sampleInterval = configSettings->numberOfScheduleWindows > 0 ? 0 : configSettings->sampleInterval;
+    fileHeader.buffersPerRecord = buffersToCollect;
+    fileHeader.oversampleRate = configSettings->oversampleRate;
+    fileHeader.clockDivider = configSettings->clockDivider;
+    fileHeader.acquisitionCycles = configSettings->acquisitionCycles;
+    fileHeader.gainRange = configSettings->gainRange;
+    fileHeader.gain = configSettings->gain;
+    fileHeader.window = multitaperEnabled ? SF_WINDOW_DPSS : SF_WINDOW_HANN;
+    memcpy(fileHeader.firmwareVersion, firmwareVersion, AM_FIRMWARE_VERSION_LENGTH);
+    memcpy(fileHeader.firmwareDescription, firmwareDescription, AM_FIRMWARE_DESCRIPTION_LENGTH);
+    memcpy(fileHeader.deviceID, (void*)AM_UNIQUE_ID_START_ADDRESS, AM_UNIQUE_ID_SIZE_IN_BYTES);
+}
+/* Function to append the record to the file named after the time of its first record */
+static SF_appendResult_t appendRecordToFile(uint16_t flags) {
     struct tm time;
     time_t rawTime = *timeOfFirstSample;
     gmtime_r(&rawTime, &time);
     sprintf(filename, "%04d%02d%02d_%02d%02d%02d.BIN", YEAR_OFFSET + time.tm_year, MONTH_OFFSET + time.tm_mon, time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec);
-    FLASH_LED_AND_RETURN_ON_ERROR(AudioMoth_appendFile(filename));
-    FLASH_LED_AND_RETURN_ON_ERROR(AudioMoth_writeToFile(timeOfNextSample, sizeof(uint32_t)));
-    FLASH_LED_AND_RETURN_ON_ERROR(AudioMoth_writeToFile(powerBuffer, sizeof(float) * FFT_HALF_LENGTH));
-    FLASH_LED_AND_RETURN_ON_ERROR(AudioMoth_closeFile());   
+    return SpectrumFile_appendRecord(filename, &fileHeader, *timeOfNextSample, flags, recordSections, numberOfRecordSections);
+}
+/* Function to append results */
+static bool writeDataToFile(uint16_t flags) {
+    /* Start a new file once the hourly index is full */
+    if (!SF_IS_WITHIN_INDEX(*timeOfFirstSample, *timeOfNextSample)) *timeOfFirstSample = *timeOfNextSample;
+    initialiseFileHeader();
+    SF_appendResult_t result = appendRecordToFile(flags);
+    /* A file which cannot take the record, such as one whose sections changed when the external SRAM did not enable, gives way to a new file starting with the record */
+    if (result == SF_APPEND_INCOMPATIBLE && *timeOfFirstSample != *timeOfNextSample) {
+        *timeOfFirstSample = *timeOfNextSample;
+        result = appendRecordToFile(flags);
+    }
+    FLASH_LED_AND_RETURN_ON_ERROR(result == SF_APPEND_SUCCESS);
+    return true;
+}
+/* Function to write the audio around the first detection, named after the time of its first sample to the millisecond */
+static bool writeSnippetToFile() {
+    uint64_t milliseconds = (uint64_t)*timeOfNextSample * MILLISECONDS_IN_SECOND + DELAY_BEFORE_FIRST_SAMPLE + (uint64_t)Snippet_getFirstSample() * MILLISECONDS_IN_SECOND / configSettings->sampleRate;
+    struct tm time;
+    time_t rawTime = milliseconds / MILLISECONDS_IN_SECOND;
+    gmtime_r(&rawTime, &time);
+    sprintf(filename, "%04d%02d%02d_%02d%02d%02d_%03d.WAV", YEAR_OFFSET + time.tm_year, MONTH_OFFSET + time.tm_mon, time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec, (int)(milliseconds % MILLISECONDS_IN_SECOND));
+    FLASH_LED_AND_RETURN_ON_ERROR(Snippet_write(filename));
     return true;
 }
 /* Main function */
 int main() {
-    /* Initialise device */
+    /* Initialise device. The cycle counter and the boot time are taken first so the profile includes initialisation */
+    if (RECORD_PROFILE) Profile_start();
     AudioMoth_initialise();
+    TRACE_ENABLE()
     /* Read the time */
     uint32_t currentTime, currentMilliseconds;
     AudioMoth_getTime(&currentTime, &currentMilliseconds);
@@ -194,57 +547,104 @@ int main() {
     if (AudioMoth_isInitialPowerUp()) {
         *timeOfNextSample = UINT32_MAX;
         *previousSwitchPosition = AM_SWITCH_NONE;
+        *configurationChanged = true;
+        Profile_reset(profileState);
+        NoiseFloor_reset(noiseFloorState);
+    }
+    PROFILE_MARK(PROFILE_PHASE_INITIALISE)
+    /* Validate the stored configuration once and then use the copy in the backup domain */
+    if (*configurationChanged) {
+        Config_load(configSettings, &defaultConfigSettings, FFT_LENGTH);
+        Schedule_reset(scheduleState);
+        NoiseFloor_reset(noiseFloorState);
+        *configurationChanged = false;
     }
     /* Check the switch position and handle USB/OFF position */
     AM_switchPosition_t switchPosition = AudioMoth_getSwitchPosition();
     if (switchPosition == AM_SWITCH_USB) {
         /* Handle the case that the switch is in USB position. Waits in low energy state until USB disconnected or switch moved  */
+        Download_initialise((uint8_t*)fftBuffer);
         AudioMoth_handleUSB();
+        if (liveModeRunning) stopLiveMode();
+        Download_stop();
         SAVE_SWITCH_POSITION_AND_POWER_DOWN(SHORT_WAIT_INTERVAL);
     }
     /* Check if just switched to CUSTOM or DEFAULT */
     if (switchPosition != *previousSwitchPosition) {
-        struct tm time;
-        time_t rawTime = currentTime;
-        gmtime_r(&rawTime, &time);
-        uint32_t currentSeconds = time.tm_hour * SECONDS_IN_HOUR + time.tm_min * SECONDS_IN_MINUTE + time.tm_sec;
-        if (currentSeconds % ACOUSTIC_SAMPLE_INTERVAL == 0) {
-            *timeOfNextSample = currentTime + ACOUSTIC_SAMPLE_INTERVAL;
-        } else {
-            *timeOfNextSample = currentTime + ACOUSTIC_SAMPLE_INTERVAL - (currentSeconds % ACOUSTIC_SAMPLE_INTERVAL);
-        }
+        scheduleNextSample(currentTime);
         *timeOfFirstSample = *timeOfNextSample;
         SAVE_SWITCH_POSITION_AND_POWER_DOWN(DEFAULT_WAIT_INTERVAL);
     }
     /* Check time */
     int64_t millisecondsUntilNextSample = (int64_t)*timeOfNextSample * MILLISECONDS_IN_SECOND - (int64_t)currentTime * MILLISECONDS_IN_SECOND - (int64_t)currentMilliseconds;
     if (millisecondsUntilNextSample > MILLISECONDS_IN_SECOND) {
-        /* Flash green LED */
-        FLASH_LED(Green, VERY_SHORT_LED_FLASH_DURATION)        
-        /* Power down and wake up */
-        SAVE_SWITCH_POSITION_AND_POWER_DOWN(DEFAULT_WAIT_INTERVAL);
-    } 
+        /* Sleep until the final second or power down so the next wake up handles the new switch position */
+        if (!sleepUntilNextSample(switchPosition)) SAVE_SWITCH_POSITION_AND_POWER_DOWN(SHORT_WAIT_INTERVAL);
+        AudioMoth_getTime(&currentTime, &currentMilliseconds);
+        millisecondsUntilNextSample = (int64_t)*timeOfNextSample * MILLISECONDS_IN_SECOND - (int64_t)currentTime * MILLISECONDS_IN_SECOND - (int64_t)currentMilliseconds;
+    }
+    /* Flag records which start more than a second late */
+    uint16_t recordFlags = millisecondsUntilNextSample < -MILLISECONDS_IN_SECOND ? SF_FLAG_DELAYED : 0;
     /* Slow down the processor */
     AudioMoth_setClockDivider(AM_HF_CLK_DIV4);
     /* Wait final period before sample */
     if (millisecondsUntilNextSample > 0) {
         AudioMoth_delay(millisecondsUntilNextSample);
     }
+    PROFILE_MARK(PROFILE_PHASE_WAIT)
+    /* High sample rates only transform triggered buffers and need the full clock to do so within a buffer period */
+    highRateMode = configSettings->sampleRate >= HIGH_RATE_MINIMUM_SAMPLE_RATE;
+    /* The multitaper estimate replaces the power sums of the separate frames, and needs the full clock for its extra transforms */
+    multitaperEnabled = USE_MULTITAPER && !AVERAGE_FFT && !highRateMode;
+    buffersToCollect = multitaperEnabled ? (configSettings->buffersToCollect + MULTITAPER_NUMBER_OF_TAPERS - 1) / MULTITAPER_NUMBER_OF_TAPERS : configSettings->buffersToCollect;
+    if (highRateMode || multitaperEnabled) AudioMoth_setClockDivider(AM_HF_CLK_DIV1);
     /* Enable the microphone and collect samples */
     dataReady = false;
+    buffersReceived = 0;
+    /* Counts the buffers which were transformed, which in high-rate mode are only the triggered ones */
     uint32_t numberOfBuffers = 0;
-    AudioMoth_enableMicrophone(AM_NORMAL_GAIN_RANGE, AM_GAIN_MEDIUM, CLOCK_DIVIDER, ACQUISITION_CYCLES, OVERSAMPLE_RATE);
+    uint32_t processingCycles = 0;
+    uint32_t inferenceCycles = 0;
+    uint32_t amplitudeNormalisingConstant = (1 << 11) * configSettings->oversampleRate;
+    if (RECORD_INDICES) Indices_initialise(configSettings->sampleRate, FFT_LENGTH, amplitudeNormalisingConstant);
+    bool externalSRAMEnabled = (RECORD_STATISTICS || SAVE_SNIPPETS) && AudioMoth_enableExternalSRAM();
+    statisticsEnabled = RECORD_STATISTICS && externalSRAMEnabled;
+    if (statisticsEnabled) Statistics_initialise(statisticsState, FFT_LENGTH, amplitudeNormalisingConstant);
+    /* The snippet ring takes the external SRAM left after the spectral statistics */
+    uint32_t snippetRingOffset = statisticsEnabled ? sizeof(statisticsState_t) : 0;
+    snippetEnabled = SAVE_SNIPPETS && externalSRAMEnabled && Snippet_initialise((int16_t*)(AM_EXTERNAL_SRAM_START_ADDRESS + snippetRingOffset), AM_EXTERNAL_SRAM_SIZE_IN_BYTES - snippetRingOffset, FFT_LENGTH, configSettings->sampleRate);
+    if (RECORD_NOISE_FLOOR) NoiseFloor_initialise(FFT_HALF_LENGTH, amplitudeNormalisingConstant);
+    if (RECORD_ONSETS) Onsets_initialise(FFT_HALF_LENGTH, amplitudeNormalisingConstant);
+    if (RECORD_MEL_FEATURES || RUN_CLASSIFIER) Mel_initialise(&melFeatures, configSettings->sampleRate, FFT_LENGTH, amplitudeNormalisingConstant, buffersToCollect);
+    classifierEnabled = RUN_CLASSIFIER && Classifier_initialise(classifierModel, MEL_NUMBER_OF_BANDS);
+    if (RECORD_LEVELS) Levels_initialise(configSettings->sampleRate, FFT_LENGTH, amplitudeNormalisingConstant, configSettings->levelCalibration);
+    if (highRateMode) Trigger_initialise(FFT_LENGTH, amplitudeNormalisingConstant);
+    uint32_t adcClockDivider = highRateMode || multitaperEnabled ? FULL_CLOCK_DIVIDER_MULTIPLIER * configSettings->clockDivider : configSettings->clockDivider;
+    AudioMoth_enableMicrophone(configSettings->gainRange, configSettings->gain, adcClockDivider, configSettings->acquisitionCycles, configSettings->oversampleRate);
     AudioMoth_initialiseDirectMemoryAccess(primaryBuffer, secondaryBuffer, FFT_LENGTH);
     AudioMoth_delay(DELAY_BEFORE_FIRST_SAMPLE);
-    AudioMoth_startMicrophoneSamples(SAMPLE_RATE);
+    PROFILE_MARK(PROFILE_PHASE_SETTLE)
+    AudioMoth_startMicrophoneSamples(configSettings->sampleRate);
     while (true) { 
         if (dataReady) {
-            if (numberOfBuffers == NUMBER_OF_BUFFERS_TO_COLLECT - 1) AudioMoth_disableMicrophone();
+            if (!highRateMode && !snippetEnabled && numberOfBuffers == buffersToCollect - 1) AudioMoth_disableMicrophone();
+            uint32_t processingStart = Profile_getCycleCount();
             AudioMoth_setGreenLED(true);
-            FFT_realTransform(dataBuffer, fftBuffer);
+            if (multitaperEnabled) {
+                Multitaper_transform(dataBuffer, fftBuffer, powerBuffer, FFT_HALF_LENGTH, numberOfBuffers == 0);
+            } else {
+                FFT_realTransform(dataBuffer, fftBuffer);
+            }
             AudioMoth_setGreenLED(false);
+            /* The DMA starts to refill a buffer once the next one completes, so a frame whose transform ran past that point is dropped rather than used */
+            if (highRateMode && buffersReceived != dataSequence) {
+                Trigger_dropFrame();
+                dataReady = false;
+                continue;
+            }
             /* Update average FFT buffer or power buffer */
-            if (numberOfBuffers == 0) {
+            TRACE_EVENT(TRACE_EVENT_POWER_START, numberOfBuffers)
+            if (!multitaperEnabled && numberOfBuffers == 0) {
                 for (uint32_t i = 0; i < FFT_HALF_LENGTH; i += 1) {
 #if AVERAGE_FFT
                     meanAmplitudeBuffer[2*i] = fftBuffer[2*i];
@@ -253,7 +653,7 @@ int main() {
                     powerBuffer[i] = fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1];
 #endif
                 }
-            } else {
+            } else if (!multitaperEnabled) {
                 for (uint32_t i = 0; i < FFT_HALF_LENGTH; i += 1) {
 #if AVERAGE_FFT
                     meanAmplitudeBuffer[2*i] += fftBuffer[2*i];
@@ -263,39 +663,91 @@ int main() {
 #endif
                 }
             }
-            /* Update counter and reset flag */
+            TRACE_EVENT(TRACE_EVENT_POWER_END, numberOfBuffers)
+            /* Update the running sums of the soundscape indices */
+            if (RECORD_INDICES) Indices_update(fftBuffer);
+            if (statisticsEnabled) Statistics_update(statisticsState, fftBuffer);
+            if (RECORD_NOISE_FLOOR) NoiseFloor_update(fftBuffer);
+            bool onsetDetected = RECORD_ONSETS && Onsets_update(fftBuffer);
+            if (RECORD_LEVELS) {
+                if (!highRateMode) Levels_updatePeak(dataBuffer);
+                Levels_update(fftBuffer);
+            }
+            if (RECORD_MEL_FEATURES) Mel_update(&melFeatures, fftBuffer);
+            /* Classify the Mel band levels of the frame */
+            bool framePositive = false;
+            if (classifierEnabled) {
+                float melLevels[MEL_NUMBER_OF_BANDS];
+                Mel_calculateLevels(fftBuffer, melLevels);
+                uint32_t inferenceStart = Profile_getCycleCount();
+                framePositive = Classifier_update(melLevels);
+                inferenceCycles += Profile_getCycleCount() - inferenceStart;
+            }
+            /* The classifier picks out the frames to capture when it runs, and otherwise any onset does */
+            bool detected = classifierEnabled ? framePositive : onsetDetected;
+            if (snippetEnabled && detected) Snippet_trigger(dataSequence);
+            /* Update counters and reset flag */
+            processingCycles += Profile_getCycleCount() - processingStart;
             numberOfBuffers += 1;
             dataReady = false;
         }
-        if (numberOfBuffers == NUMBER_OF_BUFFERS_TO_COLLECT) break;
+        if (!highRateMode && numberOfBuffers == buffersToCollect) break;
+        if (highRateMode && buffersReceived >= buffersToCollect && !dataReady) break;
         /* Go to sleep */
         AudioMoth_sleep();
     }
+    /* Keep sampling until the snippet has its post-trigger audio */
+    while (snippetEnabled && Snippet_isCapturing()) AudioMoth_sleep();
+    if (highRateMode || snippetEnabled) AudioMoth_disableMicrophone();
+    PROFILE_MARK(PROFILE_PHASE_ACQUISITION)
     /* Speed up the processor */
     AudioMoth_setClockDivider(AM_HF_CLK_DIV1);
-    /* Calculate and normalise the mean power */
-    uint32_t amplitudeNormalisingConstant = (1 << 11) * OVERSAMPLE_RATE;
+    /* Calculate the soundscape indices */
+    if (RECORD_INDICES) Indices_calculate(&indices);
+    if (statisticsEnabled) Statistics_calculate(statisticsState);
+    if (RECORD_NOISE_FLOOR) {
+        NoiseFloor_calculate(noiseFloorState);
+        noiseFloor = *noiseFloorState;
+    }
+    if (RECORD_ONSETS) Onsets_calculate(&onsets);
+    if (RECORD_LEVELS) Levels_calculate(&levels);
+    if (highRateMode) Trigger_calculate(&trigger, numberOfBuffers, processingCycles);
+    if (RECORD_MEL_FEATURES) Mel_calculate(&melFeatures);
+    if (classifierEnabled) Classifier_calculate(&classification, inferenceCycles);
+    /* Calculate and normalise the mean power over the frames which were transformed */
+    float numberOfFrames = MAX(numberOfBuffers, 1);
 #if AVERAGE_FFT
     for (uint32_t i = 0; i < FFT_HALF_LENGTH; i += 1) {
         powerBuffer[i] = meanAmplitudeBuffer[2*i] * meanAmplitudeBuffer[2*i] + meanAmplitudeBuffer[2*i+1] * meanAmplitudeBuffer[2*i+1];
-        powerBuffer[i] *= 4.0f / (float)amplitudeNormalisingConstant / (float)amplitudeNormalisingConstant / (float)NUMBER_OF_BUFFERS_TO_COLLECT / (float)NUMBER_OF_BUFFERS_TO_COLLECT;
+        powerBuffer[i] *= Decibels_powerNormalisation(amplitudeNormalisingConstant) / numberOfFrames / numberOfFrames;
     }
 #else
     for (uint32_t i = 0; i < FFT_HALF_LENGTH; i += 1) {
-        powerBuffer[i] *= 4.0f / (float)amplitudeNormalisingConstant / (float)amplitudeNormalisingConstant / (float)NUMBER_OF_BUFFERS_TO_COLLECT;
+        powerBuffer[i] *= Decibels_powerNormalisation(amplitudeNormalisingConstant) / numberOfFrames;
     }
 #endif
-    /* Append the file */
-    if (WRITE_FILE) {
+    /* Find the strongest tonal components of the mean spectrum */
+    if (RECORD_PEAKS) Peaks_find(powerBuffer, FFT_HALF_LENGTH, (float)configSettings->sampleRate / (float)FFT_LENGTH, &peaks);
+    /* Append the file, leaving out records without a positive frame if required */
+    bool success = true;
+    bool keepRecord = KEEP_POSITIVE_RECORDS_ONLY == false || classifierEnabled == false || classification.positiveFrames > 0;
+    if (WRITE_FILE && keepRecord) {
         AudioMoth_setRedLED(true);
         AudioMoth_enableFileSystem(AM_SD_CARD_HIGH_SPEED);
-        bool success = writeDataToFile();
-        if (success == false) *timeOfFirstSample = *timeOfNextSample + ACOUSTIC_SAMPLE_INTERVAL;
+        PROFILE_MARK(PROFILE_PHASE_FILE_SYSTEM)
+        success = writeDataToFile(recordFlags);
+        if (snippetEnabled && Snippet_isTriggered()) writeSnippetToFile();
+        PROFILE_MARK(PROFILE_PHASE_WRITE)
+        if (RECORD_PROFILE) Profile_appendRecord(profileState, *timeOfNextSample, processingCycles);
         AudioMoth_disableFileSystem(); 
         AudioMoth_setRedLED(false);
+    } else if (RECORD_PROFILE) {
+        Profile_endCycle(profileState);
     }
-    /* Schedule next sample */
-    *timeOfNextSample += ACOUSTIC_SAMPLE_INTERVAL;
+    if (externalSRAMEnabled) AudioMoth_disableExternalSRAM();
+    /* Schedule next sample and start a new file after a write failure */
+    scheduleNextSample(*timeOfNextSample);
+    if (success == false) *timeOfFirstSample = *timeOfNextSample;
     /* Power down and wake up */
     SAVE_SWITCH_POSITION_AND_POWER_DOWN(DEFAULT_WAIT_INTERVAL);
 }
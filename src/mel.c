@@ -0,0 +1,267 @@
+/****************************************************************************
+ * mel.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "mel.h"
+#include "decibels.h"
+#include "mel_tables.h"
+
+#if MEL_NUMBER_OF_BANDS != DCT_NUMBER_OF_INPUTS || MEL_NUMBER_OF_COEFFICIENTS != DCT_NUMBER_OF_OUTPUTS
+    #error "DCT table does not match the number of Mel bands and coefficients"
+#endif
+
+/* Useful constants */
+
+#define DCT_FRACTION_BITS                       15
+
+#define MEL_SCALE                               2595.0f
+#define MEL_BREAK_FREQUENCY                     700.0f
+
+/* Useful macros */
+
+#define MAX(a, b)                               ((a) > (b) ? (a) : (b))
+
+/* Band levels are summed in the same format as the output */
+
+#if MEL_FIXED_POINT
+    typedef int32_t levelSum_t;
+#else
+    typedef float levelSum_t;
+#endif
+
+/* Triangular Mel filters. Filter m rises from edge m to edge m + 1 and falls to edge m + 2, so each bin is shared by at most two filters */
+
+static uint32_t numberOfBins;
+
+static float binEdges[MEL_NUMBER_OF_BANDS + 2];
+
+static float edgeScale[MEL_NUMBER_OF_BANDS + 1];
+
+/* Conversion from log2 of the band power to the output level */
+
+static float levelScale;
+
+static float levelOffset;
+
+static int32_t fixedLevelScale;
+
+static int32_t fixedLevelOffset;
+
+/* Band levels summed over the frames of the current vector */
+
+static uint32_t framesPerVector;
+
+static uint32_t framesInVector;
+
+static levelSum_t levelSum[MEL_NUMBER_OF_BANDS];
+
+/* Private functions */
+
+static inline float calculateDecibels(float power) {
+
+    if (power <= 0.0f) return MEL_LEVEL_FLOOR;
+
+    return MAX(MEL_LEVEL_FLOOR, levelScale * (float)Decibels_fastLog2(power) + levelOffset);
+
+}
+
+static inline levelSum_t calculateLevel(float power) {
+
+#if MEL_FIXED_POINT
+
+    if (power <= 0.0f) return MEL_LEVEL_FLOOR * MEL_STEPS_PER_DECIBEL;
+
+    int32_t level = (int32_t)(((int64_t)Decibels_fastLog2(power) * fixedLevelScale) >> 32) + fixedLevelOffset;
+
+    return MAX(MEL_LEVEL_FLOOR * MEL_STEPS_PER_DECIBEL, level);
+
+#else
+
+    return calculateDecibels(power);
+
+#endif
+
+}
+
+static inline float hertzToMel(float frequency) {
+
+    return MEL_SCALE * log10f(1.0f + frequency / MEL_BREAK_FREQUENCY);
+
+}
+
+static inline float melToHertz(float mel) {
+
+    return MEL_BREAK_FREQUENCY * (powf(10.0f, mel / MEL_SCALE) - 1.0f);
+
+}
+
+static void calculateBandPowers(float *fftBuffer, float *power) {
+
+    /* Each bin between two edges is on the rising side of one filter and the falling side of the one below. The DC bin is left out */
+
+    memset(power, 0, MEL_NUMBER_OF_BANDS * sizeof(float));
+
+    uint32_t edge = 0;
+
+    for (uint32_t k = 1; k < numberOfBins; k += 1) {
+
+        while (edge < MEL_NUMBER_OF_BANDS + 1 && (float)k >= binEdges[edge + 1]) edge += 1;
+
+        if (edge == MEL_NUMBER_OF_BANDS + 1) break;
+
+        float binPower = fftBuffer[2*k] * fftBuffer[2*k] + fftBuffer[2*k+1] * fftBuffer[2*k+1];
+
+        float weight = ((float)k - binEdges[edge]) * edgeScale[edge];
+
+        if (edge < MEL_NUMBER_OF_BANDS) power[edge] += weight * binPower;
+
+        if (edge > 0) power[edge - 1] += (1.0f - weight) * binPower;
+
+    }
+
+}
+
+static void addVector(melFeatures_t *features) {
+
+    if (framesInVector == 0 || features->numberOfVectors == MEL_MAXIMUM_NUMBER_OF_VECTORS) return;
+
+    melValue_t *vector = features->vectors[features->numberOfVectors];
+
+    levelSum_t levels[MEL_NUMBER_OF_BANDS];
+
+    for (uint32_t m = 0; m < MEL_NUMBER_OF_BANDS; m += 1) levels[m] = levelSum[m] / (levelSum_t)framesInVector;
+
+#if MEL_TYPE == MEL_TYPE_MFCC
+
+    /* DCT-II of the mean band levels with the precomputed matrix */
+
+    for (uint32_t i = 0; i < MEL_NUMBER_OF_COEFFICIENTS; i += 1) {
+
+#if MEL_FIXED_POINT
+
+        const int16_t *row = dctMatrixQ15 + i * MEL_NUMBER_OF_BANDS;
+
+        int32_t sum = 1 << (DCT_FRACTION_BITS - 1);
+
+        for (uint32_t m = 0; m < MEL_NUMBER_OF_BANDS; m += 1) sum += (int32_t)row[m] * levels[m];
+
+        sum >>= DCT_FRACTION_BITS;
+
+        vector[i] = sum < INT16_MIN ? INT16_MIN : sum > INT16_MAX ? INT16_MAX : (int16_t)sum;
+
+#else
+
+        const float *row = dctMatrix + i * MEL_NUMBER_OF_BANDS;
+
+        float sum = 0.0f;
+
+        for (uint32_t m = 0; m < MEL_NUMBER_OF_BANDS; m += 1) sum += row[m] * levels[m];
+
+        vector[i] = sum;
+
+#endif
+
+    }
+
+#else
+
+    for (uint32_t m = 0; m < MEL_NUMBER_OF_BANDS; m += 1) vector[m] = (melValue_t)levels[m];
+
+#endif
+
+    features->numberOfVectors += 1;
+
+    framesInVector = 0;
+
+    memset(levelSum, 0, sizeof(levelSum));
+
+}
+
+/* Public functions */
+
+void Mel_initialise(melFeatures_t *features, uint32_t sampleRate, uint32_t fftLength, uint32_t amplitudeNormalisingConstant, uint32_t numberOfFrames) {
+
+    numberOfBins = fftLength / 2 + 1;
+
+    /* Filter edges are evenly spaced in Mel from zero to the Nyquist frequency and kept as fractional bins so narrow low filters are not lost */
+
+    float maximumMel = hertzToMel((float)sampleRate / 2.0f);
+
+    for (uint32_t i = 0; i < MEL_NUMBER_OF_BANDS + 2; i += 1) {
+
+        binEdges[i] = melToHertz(maximumMel * (float)i / (float)(MEL_NUMBER_OF_BANDS + 1)) * (float)fftLength / (float)sampleRate;
+
+    }
+
+    for (uint32_t i = 0; i < MEL_NUMBER_OF_BANDS + 1; i += 1) edgeScale[i] = 1.0f / (binEdges[i + 1] - binEdges[i]);
+
+    /* Scale the Q16 logarithm to decibels and offset it by the normalisation */
+
+    float normalisationLevel = 10.0f * log10f(Decibels_powerNormalisation(amplitudeNormalisingConstant));
+
+    levelScale = DECIBELS_PER_DOUBLING / (float)(1 << DECIBELS_LOG_FRACTION_BITS);
+
+    levelOffset = normalisationLevel;
+
+    fixedLevelScale = (int32_t)(DECIBELS_PER_DOUBLING * MEL_STEPS_PER_DECIBEL * (float)(1 << DECIBELS_LOG_FRACTION_BITS));
+
+    fixedLevelOffset = (int32_t)lroundf(normalisationLevel * MEL_STEPS_PER_DECIBEL);
+
+    /* Longer records are averaged over more frames so the vectors fit */
+
+    framesPerVector = MAX(MEL_FRAMES_PER_VECTOR, (numberOfFrames + MEL_MAXIMUM_NUMBER_OF_VECTORS - 1) / MEL_MAXIMUM_NUMBER_OF_VECTORS);
+
+    framesInVector = 0;
+
+    memset(levelSum, 0, sizeof(levelSum));
+
+    memset(features, 0, sizeof(melFeatures_t));
+
+    features->framesPerVector = framesPerVector;
+
+    features->type = MEL_TYPE;
+
+    features->format = MEL_FIXED_POINT ? MEL_FORMAT_FIXED_POINT : MEL_FORMAT_FLOAT;
+
+    features->numberOfValues = MEL_NUMBER_OF_VALUES;
+
+}
+
+void Mel_update(melFeatures_t *features, float *fftBuffer) {
+
+    float power[MEL_NUMBER_OF_BANDS];
+
+    calculateBandPowers(fftBuffer, power);
+
+    for (uint32_t m = 0; m < MEL_NUMBER_OF_BANDS; m += 1) levelSum[m] += calculateLevel(power[m]);
+
+    framesInVector += 1;
+
+    if (framesInVector == framesPerVector) addVector(features);
+
+}
+
+void Mel_calculateLevels(float *fftBuffer, float *levels) {
+
+    /* Levels of a single frame in dB for detectors, whatever the output format */
+
+    float power[MEL_NUMBER_OF_BANDS];
+
+    calculateBandPowers(fftBuffer, power);
+
+    for (uint32_t m = 0; m < MEL_NUMBER_OF_BANDS; m += 1) levels[m] = calculateDecibels(power[m]);
+
+}
+
+void Mel_calculate(melFeatures_t *features) {
+
+    /* A final partial vector is the mean of the frames it has */
+
+    addVector(features);
+
+}
@@ -0,0 +1,39 @@
+/****************************************************************************
+ * multitaper.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include "fft.h"
+#include "multitaper.h"
+#include "dpss_tables.h"
+
+#if MULTITAPER_LENGTH != DPSS_LENGTH || MULTITAPER_NUMBER_OF_TAPERS != DPSS_NUMBER_OF_TAPERS
+    #error "Taper table does not match the multitaper length and number of tapers"
+#endif
+
+/* Public functions */
+
+void Multitaper_transform(int16_t *samples, float *fftBuffer, float *powerBuffer, uint32_t numberOfBins, bool isFirstFrame) {
+
+    /* Each taper adds an independent estimate of the same buffer. The first taper goes last so its transform is left for the frame based modules */
+
+    const float weight = 1.0f / (float)MULTITAPER_NUMBER_OF_TAPERS;
+
+    for (uint32_t k = MULTITAPER_NUMBER_OF_TAPERS; k > 0; k -= 1) {
+
+        FFT_realTransformWithWindow(samples, dpssTapers[k - 1], fftBuffer);
+
+        bool isFirstEstimate = isFirstFrame && k == MULTITAPER_NUMBER_OF_TAPERS;
+
+        for (uint32_t i = 0; i < numberOfBins; i += 1) {
+
+            float power = weight * (fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1]);
+
+            powerBuffer[i] = isFirstEstimate ? power : powerBuffer[i] + power;
+
+        }
+
+    }
+
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+ * noisefloor.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+
+#include "decibels.h"
+#include "noisefloor.h"
+
+/* Useful constants */
+
+#define BITS_IN_BYTE                            8
+#define LEVELS_PER_WORD                         sizeof(uint32_t)
+
+/* Useful macros */
+
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+
+#define GET_LEVEL(state, band)                  (((state)->levels[(band) / LEVELS_PER_WORD] >> (BITS_IN_BYTE * ((band) % LEVELS_PER_WORD))) & UINT8_MAX)
+
+/* Minimum statistics of the smoothed band power over the frames of one wake */
+
+static uint32_t numberOfBins;
+
+static uint32_t numberOfFrames;
+
+static float normalisation;
+
+static float smoothedPower[NOISE_FLOOR_NUMBER_OF_BANDS];
+
+static float minimumPower[NOISE_FLOOR_NUMBER_OF_BANDS];
+
+/* Private functions */
+
+static inline uint32_t bandForBin(uint32_t bin) {
+
+    return MIN(bin / NOISE_FLOOR_BINS_PER_BAND, NOISE_FLOOR_NUMBER_OF_BANDS - 1);
+
+}
+
+/* Public functions */
+
+void NoiseFloor_reset(noiseFloorState_t *state) {
+
+    state->numberOfUpdates = 0;
+
+    for (uint32_t i = 0; i < NOISE_FLOOR_NUMBER_OF_BANDS / LEVELS_PER_WORD; i += 1) state->levels[i] = 0;
+
+}
+
+void NoiseFloor_initialise(uint32_t newNumberOfBins, uint32_t amplitudeNormalisingConstant) {
+
+    numberOfBins = newNumberOfBins;
+
+    numberOfFrames = 0;
+
+    normalisation = Decibels_powerNormalisation(amplitudeNormalisingConstant);
+
+}
+
+void NoiseFloor_update(float *fftBuffer) {
+
+    /* The last band also takes any bins beyond the whole bands */
+
+    for (uint32_t band = 0; band < NOISE_FLOOR_NUMBER_OF_BANDS; band += 1) {
+
+        uint32_t start = band * NOISE_FLOOR_BINS_PER_BAND;
+
+        uint32_t end = band == NOISE_FLOOR_NUMBER_OF_BANDS - 1 ? numberOfBins : MIN(start + NOISE_FLOOR_BINS_PER_BAND, numberOfBins);
+
+        if (end <= start) break;
+
+        float power = 0.0f;
+
+        for (uint32_t i = start; i < end; i += 1) power += fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1];
+
+        power /= (float)(end - start);
+
+        smoothedPower[band] = numberOfFrames == 0 ? power : NOISE_FLOOR_SMOOTHING * smoothedPower[band] + (1.0f - NOISE_FLOOR_SMOOTHING) * power;
+
+        minimumPower[band] = numberOfFrames == 0 ? smoothedPower[band] : MIN(minimumPower[band], smoothedPower[band]);
+
+    }
+
+    numberOfFrames += 1;
+
+}
+
+void NoiseFloor_calculate(noiseFloorState_t *state) {
+
+    if (numberOfFrames == 0) return;
+
+    /* The floor drops straight to a new minimum but rises slowly so short quiet periods are not lost */
+
+    uint32_t levels[NOISE_FLOOR_NUMBER_OF_BANDS / LEVELS_PER_WORD] = {0};
+
+    uint32_t numberOfBands = MIN(bandForBin(numberOfBins - 1) + 1, NOISE_FLOOR_NUMBER_OF_BANDS);
+
+    for (uint32_t band = 0; band < numberOfBands; band += 1) {
+
+        float level = minimumPower[band] > 0.0f ? NOISE_FLOOR_STEPS_PER_DECIBEL * (10.0f * log10f(minimumPower[band] * normalisation) + NOISE_FLOOR_BIAS - NOISE_FLOOR_LEVEL_FLOOR) : 0.0f;
+
+        float previousLevel = GET_LEVEL(state, band);
+
+        if (state->numberOfUpdates > 0 && level > previousLevel) level = MIN(level, previousLevel + NOISE_FLOOR_STEPS_PER_DECIBEL * NOISE_FLOOR_MAXIMUM_RISE);
+
+        uint32_t quantisedLevel = level < 0.0f ? 0 : level > UINT8_MAX ? UINT8_MAX : (uint32_t)(level + 0.5f);
+
+        levels[band / LEVELS_PER_WORD] |= quantisedLevel << (BITS_IN_BYTE * (band % LEVELS_PER_WORD));
+
+    }
+
+    /* Whole words are written as the backup domain requires */
+
+    for (uint32_t i = 0; i < NOISE_FLOOR_NUMBER_OF_BANDS / LEVELS_PER_WORD; i += 1) state->levels[i] = levels[i];
+
+    state->numberOfUpdates += 1;
+
+}
+
+float NoiseFloor_getPower(noiseFloorState_t *state, uint32_t bin) {
+
+    if (state->numberOfUpdates == 0) return 0.0f;
+
+    float level = NOISE_FLOOR_LEVEL_FLOOR + (float)GET_LEVEL(state, bandForBin(bin)) / NOISE_FLOOR_STEPS_PER_DECIBEL;
+
+    return powf(10.0f, level / 10.0f);
+
+}
+
+void NoiseFloor_calculateSNR(noiseFloorState_t *state, float *powerBuffer, float *snrBuffer, uint32_t length) {
+
+    /* SNR in dB of a normalised power spectrum. Bins are left at zero until there is a floor */
+
+    float floorPower = 0.0f;
+
+    for (uint32_t i = 0; i < length; i += 1) {
+
+        if (i == 0 || bandForBin(i) != bandForBin(i - 1)) floorPower = NoiseFloor_getPower(state, i);
+
+        snrBuffer[i] = floorPower > 0.0f && powerBuffer[i] > 0.0f ? 10.0f * log10f(powerBuffer[i] / floorPower) : 0.0f;
+
+    }
+
+}
@@ -0,0 +1,246 @@
+/****************************************************************************
+ * onsets.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "onsets.h"
+#include "decibels.h"
+
+/* Useful macros */
+
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                               ((a) > (b) ? (a) : (b))
+
+/* Band layout. The DC bin is left out */
+
+static uint32_t numberOfBins;
+
+static uint32_t binsPerBand;
+
+static float normalisation;
+
+/* Flux of the previous frames and its running mean and deviation */
+
+static uint32_t numberOfFrames;
+
+static uint32_t numberOfFluxes;
+
+static float previousLevels[ONSETS_NUMBER_OF_BANDS];
+
+static float previousFlux;
+
+static float meanFlux;
+
+static float deviationFlux;
+
+/* A candidate is kept for one frame to check that its flux is a peak */
+
+static bool hasCandidate;
+
+static uint32_t candidateFrame;
+
+static float candidateFlux;
+
+static float candidateLevels[ONSETS_NUMBER_OF_BANDS];
+
+static int32_t lastOnsetFrame;
+
+/* Table of onsets */
+
+static onsets_t table;
+
+/* Private functions */
+
+static uint8_t quantiseLevel(float level) {
+
+    level = ONSETS_STEPS_PER_DECIBEL * (level - ONSETS_LEVEL_FLOOR) + 0.5f;
+
+    return level < 0.0f ? 0 : level > UINT8_MAX ? UINT8_MAX : (uint8_t)level;
+
+}
+
+static void addOnset(void) {
+
+    /* Once the table is full the weakest onset is replaced */
+
+    uint32_t index = table.numberOfOnsets;
+
+    if (index == ONSETS_MAXIMUM_NUMBER) {
+
+        index = 0;
+
+        for (uint32_t i = 1; i < ONSETS_MAXIMUM_NUMBER; i += 1) {
+
+            if (table.onsets[i].flux < table.onsets[index].flux) index = i;
+
+        }
+
+        if (candidateFlux <= table.onsets[index].flux) index = ONSETS_MAXIMUM_NUMBER;
+
+    } else {
+
+        table.numberOfOnsets += 1;
+
+    }
+
+    if (index < ONSETS_MAXIMUM_NUMBER) {
+
+        onset_t *onset = table.onsets + index;
+
+        onset->flux = candidateFlux;
+
+        onset->frame = candidateFrame;
+
+        onset->reserved = 0;
+
+        for (uint32_t i = 0; i < ONSETS_NUMBER_OF_BANDS; i += 1) onset->levels[i] = quantiseLevel(candidateLevels[i]);
+
+    }
+
+    table.numberDetected += 1;
+
+    lastOnsetFrame = candidateFrame;
+
+    hasCandidate = false;
+
+}
+
+/* Public functions */
+
+void Onsets_initialise(uint32_t newNumberOfBins, uint32_t amplitudeNormalisingConstant) {
+
+    numberOfBins = newNumberOfBins;
+
+    binsPerBand = MAX(1, (numberOfBins - 1) / ONSETS_NUMBER_OF_BANDS);
+
+    normalisation = Decibels_powerNormalisation(amplitudeNormalisingConstant);
+
+    numberOfFrames = 0;
+
+    numberOfFluxes = 0;
+
+    previousFlux = 0.0f;
+
+    meanFlux = 0.0f;
+
+    deviationFlux = 0.0f;
+
+    hasCandidate = false;
+
+    lastOnsetFrame = -ONSETS_MINIMUM_GAP;
+
+    memset(&table, 0, sizeof(onsets_t));
+
+}
+
+bool Onsets_update(float *fftBuffer) {
+
+    /* Band levels in dB */
+
+    float levels[ONSETS_NUMBER_OF_BANDS];
+
+    for (uint32_t band = 0; band < ONSETS_NUMBER_OF_BANDS; band += 1) {
+
+        uint32_t start = 1 + band * binsPerBand;
+
+        uint32_t end = band == ONSETS_NUMBER_OF_BANDS - 1 ? numberOfBins : MIN(start + binsPerBand, numberOfBins);
+
+        float power = 0.0f;
+
+        for (uint32_t i = start; i < end; i += 1) power += fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1];
+
+        power = end > start ? power * normalisation / (float)(end - start) : 0.0f;
+
+        levels[band] = power > 0.0f ? MAX(ONSETS_LEVEL_FLOOR, 10.0f * log10f(power)) : ONSETS_LEVEL_FLOOR;
+
+    }
+
+    bool detected = false;
+
+    if (numberOfFrames > 0) {
+
+        /* Half-wave rectified spectral flux */
+
+        float flux = 0.0f;
+
+        for (uint32_t band = 0; band < ONSETS_NUMBER_OF_BANDS; band += 1) flux += MAX(0.0f, levels[band] - previousLevels[band]);
+
+        /* The candidate from the previous frame is an onset if the flux has not kept rising */
+
+        if (hasCandidate && candidateFlux >= flux) {
+
+            addOnset();
+
+            detected = true;
+
+        }
+
+        hasCandidate = false;
+
+        float threshold = numberOfFluxes > 0 ? MAX(ONSETS_MINIMUM_FLUX, meanFlux + ONSETS_THRESHOLD_DEVIATIONS * deviationFlux) : ONSETS_MINIMUM_FLUX;
+
+        if (flux > previousFlux && flux > threshold && (int32_t)numberOfFrames - lastOnsetFrame >= ONSETS_MINIMUM_GAP) {
+
+            hasCandidate = true;
+
+            candidateFrame = numberOfFrames;
+
+            candidateFlux = flux;
+
+            memcpy(candidateLevels, levels, sizeof(levels));
+
+        }
+
+        /* Running mean and mean absolute deviation of the flux */
+
+        float rate = MAX(1.0f / (float)(numberOfFluxes + 1), ONSETS_SMOOTHING);
+
+        meanFlux += rate * (flux - meanFlux);
+
+        deviationFlux += rate * (fabsf(flux - meanFlux) - deviationFlux);
+
+        numberOfFluxes += 1;
+
+        previousFlux = flux;
+
+    }
+
+    memcpy(previousLevels, levels, sizeof(levels));
+
+    numberOfFrames += 1;
+
+    return detected;
+
+}
+
+void Onsets_calculate(onsets_t *onsets) {
+
+    if (hasCandidate) addOnset();
+
+    /* Put the onsets back in order of frame */
+
+    for (uint32_t i = 1; i < table.numberOfOnsets; i += 1) {
+
+        onset_t onset = table.onsets[i];
+
+        uint32_t j = i;
+
+        while (j > 0 && table.onsets[j - 1].frame > onset.frame) {
+
+            table.onsets[j] = table.onsets[j - 1];
+
+            j -= 1;
+
+        }
+
+        table.onsets[j] = onset;
+
+    }
+
+    memcpy(onsets, &table, sizeof(onsets_t));
+
+}
@@ -0,0 +1,182 @@
+/****************************************************************************
+ * peaks.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "peaks.h"
+
+/* Useful constants */
+
+#define DECIBEL_FLOOR                           1e-30f
+#define HALF_POWER                              0.5f
+
+/* Useful macros */
+
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                               ((a) > (b) ? (a) : (b))
+
+/* Private functions */
+
+static float powerToLevel(float power) {
+
+    return 10.0f * log10f(power + DECIBEL_FLOOR);
+
+}
+
+static void siftDown(peak_t *heap, uint32_t size, uint32_t index) {
+
+    /* The heap keeps the quietest peak at the root so it is the one replaced */
+
+    while (true) {
+
+        uint32_t smallest = index;
+
+        uint32_t left = 2 * index + 1, right = 2 * index + 2;
+
+        if (left < size && heap[left].level < heap[smallest].level) smallest = left;
+
+        if (right < size && heap[right].level < heap[smallest].level) smallest = right;
+
+        if (smallest == index) return;
+
+        peak_t peak = heap[index];
+
+        heap[index] = heap[smallest];
+
+        heap[smallest] = peak;
+
+        index = smallest;
+
+    }
+
+}
+
+static void insertPeak(peaks_t *peaks, peak_t *peak) {
+
+    peak_t *heap = peaks->peaks;
+
+    if (peaks->numberOfPeaks < PEAKS_MAXIMUM_NUMBER) {
+
+        uint32_t index = peaks->numberOfPeaks++;
+
+        while (index > 0 && heap[(index - 1) / 2].level > peak->level) {
+
+            heap[index] = heap[(index - 1) / 2];
+
+            index = (index - 1) / 2;
+
+        }
+
+        heap[index] = *peak;
+
+    } else if (peak->level > heap[0].level) {
+
+        heap[0] = *peak;
+
+        siftDown(heap, PEAKS_MAXIMUM_NUMBER, 0);
+
+    }
+
+}
+
+static float measureBandwidth(float *powerBuffer, uint32_t numberOfBins, uint32_t bin, float halfPower) {
+
+    /* Interpolate the half power points either side of the peak */
+
+    uint32_t i = bin, j = bin;
+
+    while (i > 0 && powerBuffer[i - 1] > halfPower) i -= 1;
+
+    while (j < numberOfBins - 1 && powerBuffer[j + 1] > halfPower) j += 1;
+
+    float left = i > 0 ? (float)i - (powerBuffer[i] - halfPower) / (powerBuffer[i] - powerBuffer[i - 1]) : 0.0f;
+
+    float right = j < numberOfBins - 1 ? (float)j + (powerBuffer[j] - halfPower) / (powerBuffer[j] - powerBuffer[j + 1]) : (float)(numberOfBins - 1);
+
+    return right - left;
+
+}
+
+static float calculateFloor(float *powerBuffer, uint32_t numberOfBins, int32_t k) {
+
+    /* The floor is the mean of the neighbouring bins outside a guard band. It is summed afresh for each maximum as running sums keep the rounding residue of a loud tone */
+
+    float sum = 0.0f;
+
+    uint32_t count = 0;
+
+    int32_t start = MAX(0, k - PEAKS_FLOOR_HALF_WIDTH), end = MIN((int32_t)numberOfBins - 1, k + PEAKS_FLOOR_HALF_WIDTH);
+
+    for (int32_t i = start; i <= end; i += 1) {
+
+        if (i >= k - PEAKS_FLOOR_GUARD && i <= k + PEAKS_FLOOR_GUARD) continue;
+
+        sum += powerBuffer[i];
+
+        count += 1;
+
+    }
+
+    return count > 0 ? sum / (float)count : 0.0f;
+
+}
+
+/* Public functions */
+
+void Peaks_find(float *powerBuffer, uint32_t numberOfBins, float binWidth, peaks_t *peaks) {
+
+    memset(peaks, 0, sizeof(peaks_t));
+
+    if (numberOfBins < 3) return;
+
+    float thresholdRatio = powf(10.0f, PEAKS_THRESHOLD / 10.0f);
+
+    for (int32_t k = 1; k < (int32_t)numberOfBins - 1; k += 1) {
+
+        /* Local maxima clearly above the floor are refined by fitting a parabola to the levels of the three bins */
+
+        if (powerBuffer[k] > powerBuffer[k - 1] && powerBuffer[k] >= powerBuffer[k + 1]) {
+
+            if (powerBuffer[k] > calculateFloor(powerBuffer, numberOfBins, k) * thresholdRatio) {
+
+                float a = powerToLevel(powerBuffer[k - 1]), b = powerToLevel(powerBuffer[k]), c = powerToLevel(powerBuffer[k + 1]);
+
+                float denominator = a - 2.0f * b + c;
+
+                float offset = denominator < 0.0f ? 0.5f * (a - c) / denominator : 0.0f;
+
+                peak_t peak;
+
+                peak.frequency = ((float)k + offset) * binWidth;
+
+                peak.level = b - 0.25f * (a - c) * offset;
+
+                peak.bandwidth = binWidth * measureBandwidth(powerBuffer, numberOfBins, k, HALF_POWER * powf(10.0f, peak.level / 10.0f));
+
+                insertPeak(peaks, &peak);
+
+            }
+
+        }
+
+    }
+
+    /* Sorting the heap moves the quietest peaks to the end */
+
+    for (uint32_t i = peaks->numberOfPeaks; i > 1; i -= 1) {
+
+        peak_t peak = peaks->peaks[0];
+
+        peaks->peaks[0] = peaks->peaks[i - 1];
+
+        peaks->peaks[i - 1] = peak;
+
+        siftDown(peaks->peaks, i - 1, 0);
+
+    }
+
+}
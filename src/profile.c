@@ -0,0 +1,206 @@
+/****************************************************************************
+ * profile.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "em_device.h"
+#include "em_burtc.h"
+#include "em_cmu.h"
+
+#include "crc.h"
+#include "profile.h"
+#include "audiomoth.h"
+
+/* Temperature is stored in hundredths of a degree */
+
+#define MILLIDEGREES_IN_HUNDREDTH               10
+
+/* Record built from the ring */
+
+static profileRecord_t record;
+
+/* BURTC count when the processor woke */
+
+static uint32_t ticksAtBoot;
+
+/* Private functions */
+
+static void resetMarks(profileState_t *state) {
+
+    state->numberOfMarks = 0;
+
+    state->ticksAtReset = BURTC_CounterGet();
+
+}
+
+static void summariseMarks(profileState_t *state) {
+
+    /* The cycle counter restarts on each wake. After the ring wraps the oldest mark only provides the start of the next phase */
+
+    bool overflowed = state->numberOfMarks > PROFILE_RING_SIZE;
+
+    uint32_t firstMark = overflowed ? state->numberOfMarks - PROFILE_RING_SIZE : 0;
+
+    uint32_t previousTicks = state->ticksAtReset;
+
+    uint32_t previousCycles = 0;
+
+    for (uint32_t i = firstMark; i < state->numberOfMarks; i += 1) {
+
+        profileMark_t *mark = state->marks + i % PROFILE_RING_SIZE;
+
+        /* Boot marks only start the initialisation phase */
+
+        if ((i > firstMark || !overflowed) && mark->phase != PROFILE_BOOT_MARK) {
+
+            record.ticks[mark->phase] += mark->ticks - previousTicks;
+
+            record.cycles[mark->phase] += mark->cycles - previousCycles;
+
+            record.clockDividers[mark->phase] = mark->clockDivider;
+
+        }
+
+        previousTicks = mark->ticks;
+
+        previousCycles = mark->cycles;
+
+    }
+
+}
+
+/* Public functions */
+
+void Profile_start(void) {
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    DWT->CYCCNT = 0;
+
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* The BURTC keeps counting through EM4, and only needs the low energy interface clock to be read */
+
+    CMU_ClockEnable(cmuClock_CORELE, true);
+
+    ticksAtBoot = BURTC_CounterGet();
+
+}
+
+uint32_t Profile_getCycleCount(void) {
+
+    return DWT->CYCCNT;
+
+}
+
+void Profile_reset(profileState_t *state) {
+
+    state->numberOfCycles = 0;
+
+    resetMarks(state);
+
+}
+
+void Profile_mark(profileState_t *state, PROFILE_phase_t phase) {
+
+    if (phase == PROFILE_PHASE_INITIALISE) {
+
+        profileMark_t *bootMark = state->marks + state->numberOfMarks % PROFILE_RING_SIZE;
+
+        bootMark->phase = PROFILE_BOOT_MARK;
+
+        bootMark->clockDivider = 0;
+
+        bootMark->cycles = 0;
+
+        bootMark->ticks = ticksAtBoot;
+
+        state->numberOfMarks += 1;
+
+    }
+
+    profileMark_t *mark = state->marks + state->numberOfMarks % PROFILE_RING_SIZE;
+
+    mark->phase = phase;
+
+    mark->clockDivider = AudioMoth_getClockDivider();
+
+    mark->cycles = DWT->CYCCNT;
+
+    mark->ticks = BURTC_CounterGet();
+
+    state->numberOfMarks += 1;
+
+}
+
+void Profile_endCycle(profileState_t *state) {
+
+    /* A cycle which writes no record is still counted and its marks are dropped so the next cycle starts afresh */
+
+    state->numberOfCycles += 1;
+
+    resetMarks(state);
+
+}
+
+bool Profile_appendRecord(profileState_t *state, uint32_t time, uint32_t processingCycles) {
+
+    /* Only every few cycles are logged so the log itself costs little */
+
+    state->numberOfCycles += 1;
+
+    if (state->numberOfCycles % PROFILE_RECORD_INTERVAL != 0) {
+
+        resetMarks(state);
+
+        return true;
+
+    }
+
+    memset(&record, 0, sizeof(profileRecord_t));
+
+    record.version = PROFILE_VERSION;
+
+    record.size = sizeof(profileRecord_t);
+
+    record.time = time;
+
+    record.numberOfMarks = state->numberOfMarks;
+
+    record.processingCycles = processingCycles;
+
+    summariseMarks(state);
+
+    /* Read the supply voltage and the temperature */
+
+    record.supplyVoltage = AudioMoth_getSupplyVoltage();
+
+    AudioMoth_enableTemperature();
+
+    record.temperature = AudioMoth_getTemperature() / MILLIDEGREES_IN_HUNDREDTH;
+
+    AudioMoth_disableTemperature();
+
+    record.crc = CRC_update(0, (uint8_t*)&record, offsetof(profileRecord_t, crc));
+
+    resetMarks(state);
+
+    /* Append the record */
+
+    if (!AudioMoth_appendFile(PROFILE_FILENAME)) return false;
+
+    if (!AudioMoth_writeToFile(&record, sizeof(profileRecord_t))) {
+
+        AudioMoth_closeFile();
+
+        return false;
+
+    }
+
+    return AudioMoth_closeFile();
+
+}
@@ -0,0 +1,197 @@
+/****************************************************************************
+ * schedule.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sunrise.h"
+#include "schedule.h"
+
+/* Time constants */
+
+#define SECONDS_IN_MINUTE                       60
+#define MINUTES_IN_DAY                          1440
+#define SECONDS_IN_DAY                          86400
+
+#define MICRODEGREES_IN_DEGREE                  1000000.0f
+
+/* Private functions */
+
+static int32_t referenceMinutes(uint8_t reference, uint32_t dawnMinutes, uint32_t duskMinutes) {
+
+    return reference == CONFIG_REFERENCE_DAWN ? dawnMinutes : reference == CONFIG_REFERENCE_DUSK ? duskMinutes : 0;
+
+}
+
+static bool calculateWindow(configSettings_t *settings, scheduleWindow_t *window, uint32_t day, uint32_t *start, uint32_t *end) {
+
+    uint32_t startOfDay = day * SECONDS_IN_DAY;
+
+    uint32_t dawnMinutes = 0, duskMinutes = 0;
+
+    SR_solution_t solution = SR_NORMAL_SOLUTION;
+
+    if (window->startReference != CONFIG_REFERENCE_ABSOLUTE || window->endReference != CONFIG_REFERENCE_ABSOLUTE) {
+
+        SR_trend_t trend;
+
+        float latitude = (float)settings->latitude / MICRODEGREES_IN_DEGREE;
+
+        float longitude = (float)settings->longitude / MICRODEGREES_IN_DEGREE;
+
+        Sunrise_calculateFromUnix(window->event, startOfDay + SECONDS_IN_DAY / 2, latitude, longitude, &solution, &trend, &dawnMinutes, &duskMinutes);
+
+    }
+
+    /* When the event does not happen, only a dawn to dusk window in constant light or a dusk to dawn window in constant dark is kept, and it covers the whole day */
+
+    if (solution != SR_NORMAL_SOLUTION) {
+
+        bool isDayWindow = window->startReference == CONFIG_REFERENCE_DAWN && window->endReference == CONFIG_REFERENCE_DUSK;
+
+        bool isNightWindow = window->startReference == CONFIG_REFERENCE_DUSK && window->endReference == CONFIG_REFERENCE_DAWN;
+
+        if (!(isDayWindow && solution == SR_SUN_ABOVE_HORIZON) && !(isNightWindow && solution == SR_SUN_BELOW_HORIZON)) return false;
+
+        *start = startOfDay;
+
+        *end = startOfDay + SECONDS_IN_DAY;
+
+        return true;
+
+    }
+
+    /* Windows which end before they start run past midnight */
+
+    int32_t startMinutes = referenceMinutes(window->startReference, dawnMinutes, duskMinutes) + window->startMinutes;
+
+    int32_t endMinutes = referenceMinutes(window->endReference, dawnMinutes, duskMinutes) + window->endMinutes;
+
+    while (endMinutes <= startMinutes) endMinutes += MINUTES_IN_DAY;
+
+    *start = startOfDay + startMinutes * SECONDS_IN_MINUTE;
+
+    *end = startOfDay + endMinutes * SECONDS_IN_MINUTE;
+
+    return true;
+
+}
+
+static void calculatePeriods(configSettings_t *settings, scheduleState_t *state, uint32_t day) {
+
+    /* Windows from the previous day can run into this one. Each window keeps its slot so its mode can be found from the period */
+
+    uint32_t startOfDay = day * SECONDS_IN_DAY;
+
+    for (uint32_t dayOffset = 0; dayOffset < 2; dayOffset += 1) {
+
+        for (uint32_t i = 0; i < CONFIG_MAXIMUM_SCHEDULE_WINDOWS; i += 1) {
+
+            uint32_t start = 0, end = 0;
+
+            scheduleWindow_t *window = settings->scheduleWindows + i;
+
+            schedulePeriod_t *period = state->periods + dayOffset * CONFIG_MAXIMUM_SCHEDULE_WINDOWS + i;
+
+            bool overlapsDay = i < settings->numberOfScheduleWindows && calculateWindow(settings, window, day + dayOffset - 1, &start, &end) && end > startOfDay && start < startOfDay + SECONDS_IN_DAY;
+
+            period->start = overlapsDay ? start : 0;
+
+            period->end = overlapsDay ? end : 0;
+
+            period->sampleInterval = window->sampleInterval;
+
+        }
+
+    }
+
+    state->day = day;
+
+}
+
+static bool findSampleTime(configSettings_t *settings, scheduleState_t *state, uint32_t currentTime, uint32_t *nextSampleTime) {
+
+    /* Samples in each period are aligned to its start and must fall within the day. Windows which share the sample time share its mode */
+
+    bool found = false;
+
+    uint32_t endOfDay = (state->day + 1) * SECONDS_IN_DAY;
+
+    for (uint32_t i = 0; i < SCHEDULE_MAXIMUM_PERIODS; i += 1) {
+
+        schedulePeriod_t *period = state->periods + i;
+
+        if (currentTime >= period->end) continue;
+
+        uint32_t sampleTime = period->start;
+
+        if (currentTime >= period->start) sampleTime += ((currentTime - period->start) / period->sampleInterval + 1) * period->sampleInterval;
+
+        if (sampleTime >= period->end || sampleTime >= endOfDay) continue;
+
+        uint32_t mode = settings->scheduleWindows[i % CONFIG_MAXIMUM_SCHEDULE_WINDOWS].mode;
+
+        if (!found || sampleTime < *nextSampleTime) {
+
+            *nextSampleTime = sampleTime;
+
+            state->nextSampleMode = mode;
+
+        } else if (sampleTime == *nextSampleTime) {
+
+            state->nextSampleMode |= mode;
+
+        }
+
+        found = true;
+
+    }
+
+    return found;
+
+}
+
+/* Public functions */
+
+void Schedule_reset(scheduleState_t *state) {
+
+    state->day = UINT32_MAX;
+
+    state->nextSampleMode = CONFIG_SCHEDULE_MODE_ALL;
+
+}
+
+bool Schedule_getNextSampleTime(configSettings_t *settings, scheduleState_t *state, uint32_t currentTime, uint32_t *nextSampleTime) {
+
+    /* Without a schedule samples are aligned to the start of each day */
+
+    if (settings->numberOfScheduleWindows == 0) {
+
+        uint32_t secondsOfDay = currentTime % SECONDS_IN_DAY;
+
+        *nextSampleTime = currentTime - secondsOfDay % settings->sampleInterval + settings->sampleInterval;
+
+        state->nextSampleMode = CONFIG_SCHEDULE_MODE_ALL;
+
+        return true;
+
+    }
+
+    /* Periods are only calculated once per day so most calls just compare times */
+
+    uint32_t day = currentTime / SECONDS_IN_DAY;
+
+    for (uint32_t i = 0; i < SCHEDULE_MAXIMUM_DAYS_TO_SEARCH; i += 1) {
+
+        if (state->day != day + i) calculatePeriods(settings, state, day + i);
+
+        if (findSampleTime(settings, state, currentTime, nextSampleTime)) return true;
+
+    }
+
+    return false;
+
+}
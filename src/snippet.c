@@ -0,0 +1,217 @@
+/****************************************************************************
+ * snippet.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "snippet.h"
+#include "audiomoth.h"
+
+/* Useful constants */
+
+#define MILLISECONDS_IN_SECOND                  1000
+#define WAV_FORMAT_PCM                          1
+
+/* Useful macros */
+
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                               ((a) > (b) ? (a) : (b))
+
+#define CLOSE_AND_RETURN_ON_ERROR(fn) { \
+    bool success = (fn); \
+    if (success != true) { \
+        AudioMoth_closeFile(); \
+        return false; \
+    } \
+}
+
+/* Ring of the most recent buffers in the external SRAM */
+
+static int16_t *ring;
+
+static uint32_t numberOfSlots;
+
+static uint32_t samplesPerBuffer;
+
+static uint32_t sampleRate;
+
+static uint32_t preTriggerBuffers;
+
+static uint32_t postTriggerBuffers;
+
+/* Capture state. Buffers are numbered from one as they arrive and the interrupt handler updates the count while the main loop runs */
+
+static volatile uint32_t buffersStored;
+
+static volatile uint32_t triggerBuffer;
+
+static snippetHeader_t header;
+
+/* Private functions */
+
+static void setChunk(snippetChunk_t *chunk, char *id, uint32_t size) {
+
+    memcpy(chunk->id, id, sizeof(chunk->id));
+
+    chunk->size = size;
+
+}
+
+static void initialiseHeader(uint32_t numberOfSamples) {
+
+    uint32_t dataSize = numberOfSamples * sizeof(int16_t);
+
+    memset(&header, 0, sizeof(snippetHeader_t));
+
+    setChunk(&header.riff, "RIFF", sizeof(snippetHeader_t) - sizeof(snippetChunk_t) + dataSize);
+
+    memcpy(header.format, "WAVE", sizeof(header.format));
+
+    setChunk(&header.fmt, "fmt ", offsetof(snippetHeader_t, junk) - offsetof(snippetHeader_t, audioFormat));
+
+    header.audioFormat = WAV_FORMAT_PCM;
+
+    header.numberOfChannels = 1;
+
+    header.samplesPerSecond = sampleRate;
+
+    header.bytesPerSecond = sampleRate * sizeof(int16_t);
+
+    header.bytesPerCapture = sizeof(int16_t);
+
+    header.bitsPerSample = 8 * sizeof(int16_t);
+
+    setChunk(&header.junk, "JUNK", sizeof(header.padding));
+
+    setChunk(&header.data, "data", dataSize);
+
+}
+
+static uint32_t firstBuffer(void) {
+
+    uint32_t oldestStored = buffersStored > numberOfSlots ? buffersStored - numberOfSlots + 1 : 1;
+
+    return MAX(oldestStored, triggerBuffer > preTriggerBuffers ? triggerBuffer - preTriggerBuffers : 1);
+
+}
+
+/* Public functions */
+
+bool Snippet_initialise(int16_t *newRing, uint32_t ringSize, uint32_t newSamplesPerBuffer, uint32_t newSampleRate) {
+
+    ring = newRing;
+
+    samplesPerBuffer = newSamplesPerBuffer;
+
+    sampleRate = newSampleRate;
+
+    numberOfSlots = ringSize / (samplesPerBuffer * sizeof(int16_t));
+
+    buffersStored = 0;
+
+    triggerBuffer = 0;
+
+    /* The trigger buffer and those either side of it must fit in the ring together, so both windows shrink in proportion at high sample rates */
+
+    uint32_t samplesPerMillisecond = sampleRate / MILLISECONDS_IN_SECOND;
+
+    preTriggerBuffers = (SNIPPET_PRE_TRIGGER_MILLISECONDS * samplesPerMillisecond + samplesPerBuffer - 1) / samplesPerBuffer;
+
+    postTriggerBuffers = (SNIPPET_POST_TRIGGER_MILLISECONDS * samplesPerMillisecond + samplesPerBuffer - 1) / samplesPerBuffer;
+
+    if (numberOfSlots < 2) return false;
+
+    if (preTriggerBuffers + postTriggerBuffers + 1 > numberOfSlots) {
+
+        uint32_t windowBuffers = preTriggerBuffers + postTriggerBuffers;
+
+        preTriggerBuffers = preTriggerBuffers * (numberOfSlots - 1) / windowBuffers;
+
+        postTriggerBuffers = numberOfSlots - 1 - preTriggerBuffers;
+
+    }
+
+    return true;
+
+}
+
+void Snippet_addBuffer(int16_t *samples) {
+
+    /* Once the post-trigger buffers are in, the ring is left alone so they are not overwritten */
+
+    if (triggerBuffer > 0 && buffersStored >= triggerBuffer + postTriggerBuffers) return;
+
+    memcpy(ring + (buffersStored % numberOfSlots) * samplesPerBuffer, samples, samplesPerBuffer * sizeof(int16_t));
+
+    buffersStored += 1;
+
+}
+
+void Snippet_trigger(uint32_t bufferNumber) {
+
+    /* Only the first detection of each acquisition is captured */
+
+    if (triggerBuffer == 0 && bufferNumber > 0) triggerBuffer = bufferNumber;
+
+}
+
+bool Snippet_isTriggered(void) {
+
+    return triggerBuffer > 0;
+
+}
+
+bool Snippet_isCapturing(void) {
+
+    return triggerBuffer > 0 && buffersStored < triggerBuffer + postTriggerBuffers;
+
+}
+
+uint32_t Snippet_getFirstSample(void) {
+
+    return triggerBuffer > 0 ? (firstBuffer() - 1) * samplesPerBuffer : 0;
+
+}
+
+bool Snippet_write(char *filename) {
+
+    if (triggerBuffer == 0) return false;
+
+    /* The snippet runs from the first pre-trigger buffer still in the ring to the last buffer stored */
+
+    uint32_t first = firstBuffer();
+
+    uint32_t numberOfBuffers = MIN(buffersStored, triggerBuffer + postTriggerBuffers) - first + 1;
+
+    initialiseHeader(numberOfBuffers * samplesPerBuffer);
+
+    if (!AudioMoth_openFile(filename)) return false;
+
+    CLOSE_AND_RETURN_ON_ERROR(AudioMoth_writeToFile(&header, sizeof(snippetHeader_t)));
+
+    /* The header fills a whole sector and each buffer is a whole number of sectors, so every write covers whole sectors of the file */
+
+    uint32_t ringBytes = numberOfSlots * samplesPerBuffer * sizeof(int16_t);
+
+    uint32_t position = ((first - 1) % numberOfSlots) * samplesPerBuffer * sizeof(int16_t);
+
+    uint32_t bytesRemaining = numberOfBuffers * samplesPerBuffer * sizeof(int16_t);
+
+    while (bytesRemaining > 0) {
+
+        uint32_t bytesToWrite = MIN(SNIPPET_WRITE_SIZE, MIN(bytesRemaining, ringBytes - position));
+
+        CLOSE_AND_RETURN_ON_ERROR(AudioMoth_writeToFile((uint8_t*)ring + position, bytesToWrite));
+
+        position = (position + bytesToWrite) % ringBytes;
+
+        bytesRemaining -= bytesToWrite;
+
+    }
+
+    return AudioMoth_closeFile();
+
+}
@@ -0,0 +1,174 @@
+/****************************************************************************
+ * spectrumfile.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "crc.h"
+#include "audiomoth.h"
+#include "spectrumfile.h"
+
+/* Header read from an existing file */
+
+static SF_header_t fileHeader;
+
+/* Useful macros */
+
+#define CLOSE_AND_RETURN_ON_ERROR(fn) { \
+    bool success = (fn); \
+    if (success != true) { \
+        AudioMoth_closeFile(); \
+        return SF_APPEND_ERROR; \
+    } \
+}
+
+#define CLOSE_AND_RETURN_IF_INCOMPATIBLE(fn) { \
+    bool compatible = (fn); \
+    if (compatible != true) { \
+        AudioMoth_closeFile(); \
+        return SF_APPEND_INCOMPATIBLE; \
+    } \
+}
+
+/* Private functions */
+
+static bool isCompatible(SF_header_t *header, SF_header_t *otherHeader) {
+
+    /* All acquisition settings and the firmware must match for records to share a file */
+
+    if (memcmp(header, otherHeader, offsetof(SF_header_t, baseTime)) != 0) return false;
+
+    return memcmp(header->firmwareVersion, otherHeader->firmwareVersion, offsetof(SF_header_t, indexInterval) - offsetof(SF_header_t, firmwareVersion)) == 0;
+
+}
+
+/* Public functions */
+
+void SpectrumFile_initialiseHeader(SF_header_t *header, uint32_t contents, uint32_t payloadSize) {
+
+    memset(header, 0, sizeof(SF_header_t));
+
+    memcpy(header->magic, SF_MAGIC, sizeof(header->magic));
+
+    header->version = SF_VERSION;
+
+    header->headerSize = SF_HEADER_SIZE;
+
+    header->recordSize = sizeof(SF_recordHeader_t) + payloadSize;
+
+    header->contents = contents;
+
+    header->indexInterval = SF_INDEX_INTERVAL;
+
+    header->indexEntries = SF_INDEX_ENTRIES;
+
+    memset(header->index, 0xFF, sizeof(header->index));
+
+}
+
+uint16_t SpectrumFile_calculateRecordCRC(SF_recordHeader_t *recordHeader, SF_section_t *sections, uint32_t numberOfSections) {
+
+    uint16_t crc = CRC_update(0, (uint8_t*)recordHeader, offsetof(SF_recordHeader_t, crc));
+
+    for (uint32_t i = 0; i < numberOfSections; i += 1) crc = CRC_update(crc, (uint8_t*)sections[i].data, sections[i].size);
+
+    return crc;
+
+}
+
+SF_appendResult_t SpectrumFile_appendRecord(char *filename, SF_header_t *header, uint32_t time, uint16_t flags, SF_section_t *sections, uint32_t numberOfSections) {
+
+    uint32_t payloadSize = 0;
+
+    for (uint32_t i = 0; i < numberOfSections; i += 1) payloadSize += sections[i].size;
+
+    if (header->recordSize != sizeof(SF_recordHeader_t) + payloadSize) return SF_APPEND_ERROR;
+
+    if (!AudioMoth_appendFile(filename)) return SF_APPEND_ERROR;
+
+    /* Read the header of an existing file or start a new one */
+
+    bool headerChanged = false;
+
+    uint32_t fileSize = AudioMoth_getFileSize();
+
+    if (fileSize < SF_HEADER_SIZE) {
+
+        memcpy(&fileHeader, header, sizeof(SF_header_t));
+
+        fileHeader.baseTime = SF_INDEX_BASE_TIME(time);
+
+        fileSize = SF_HEADER_SIZE;
+
+        headerChanged = true;
+
+    } else {
+
+        CLOSE_AND_RETURN_ON_ERROR(AudioMoth_seekInFile(0));
+
+        CLOSE_AND_RETURN_ON_ERROR(AudioMoth_readFile((char*)&fileHeader, sizeof(SF_header_t)));
+
+        CLOSE_AND_RETURN_IF_INCOMPATIBLE(isCompatible(&fileHeader, header));
+
+    }
+
+    /* Records from before the file or beyond its index need a new file */
+
+    CLOSE_AND_RETURN_IF_INCOMPATIBLE(time >= fileHeader.baseTime);
+
+    /* Next record follows the last complete record, so a truncated tail is overwritten */
+
+    uint32_t recordNumber = (fileSize - SF_HEADER_SIZE) / fileHeader.recordSize;
+
+    /* Point this hour and any empty hours before it at the record */
+
+    uint32_t entry = (time - fileHeader.baseTime) / SF_INDEX_INTERVAL;
+
+    CLOSE_AND_RETURN_IF_INCOMPATIBLE(entry < SF_INDEX_ENTRIES);
+
+    for (uint32_t i = 0; i <= entry; i += 1) {
+
+        if (fileHeader.index[i] == SF_INDEX_UNSET) {
+
+            fileHeader.index[i] = recordNumber;
+
+            headerChanged = true;
+
+        }
+
+    }
+
+    /* Write the record and then the header if the index has changed */
+
+    SF_recordHeader_t recordHeader;
+
+    recordHeader.time = time;
+
+    recordHeader.flags = flags | SF_FLAG_VALID;
+
+    recordHeader.crc = SpectrumFile_calculateRecordCRC(&recordHeader, sections, numberOfSections);
+
+    CLOSE_AND_RETURN_ON_ERROR(AudioMoth_seekInFile(SF_HEADER_SIZE + recordNumber * fileHeader.recordSize));
+
+    CLOSE_AND_RETURN_ON_ERROR(AudioMoth_writeToFile(&recordHeader, sizeof(SF_recordHeader_t)));
+
+    for (uint32_t i = 0; i < numberOfSections; i += 1) {
+
+        CLOSE_AND_RETURN_ON_ERROR(AudioMoth_writeToFile(sections[i].data, sections[i].size));
+
+    }
+
+    if (headerChanged) {
+
+        CLOSE_AND_RETURN_ON_ERROR(AudioMoth_seekInFile(0));
+
+        CLOSE_AND_RETURN_ON_ERROR(AudioMoth_writeToFile(&fileHeader, sizeof(SF_header_t)));
+
+    }
+
+    return AudioMoth_closeFile() ? SF_APPEND_SUCCESS : SF_APPEND_ERROR;
+
+}
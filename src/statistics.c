@@ -0,0 +1,141 @@
+/****************************************************************************
+ * statistics.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "decibels.h"
+#include "statistics.h"
+
+/* Percentiles of the frame levels. L10 is the level exceeded in 10% of frames */
+
+#define L90_PERCENTILE                          0.1f
+#define L50_PERCENTILE                          0.5f
+#define L10_PERCENTILE                          0.9f
+
+/* Useful macros */
+
+#define MIN(a, b)                               ((a) < (b) ? (a) : (b))
+
+/* Private functions */
+
+static uint8_t quantiseLevel(statisticsState_t *state, float power) {
+
+    if (power <= 0.0f) return 0;
+
+    float level = state->levelScale * (float)Decibels_fastLog2(power) + state->levelOffset + 0.5f;
+
+    return level < 0.0f ? 0 : level > UINT8_MAX ? UINT8_MAX : (uint8_t)level;
+
+}
+
+static uint8_t calculatePercentile(statisticsState_t *state, uint32_t bin, float percentile) {
+
+    /* Find the bucket holding the rank and interpolate within it */
+
+    float rank = percentile * (float)state->numberOfFrames;
+
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < STATISTICS_NUMBER_OF_BUCKETS; i += 1) {
+
+        uint32_t bucketCount = state->histograms[bin][i];
+
+        if (bucketCount > 0 && (float)(count + bucketCount) >= rank) {
+
+            float level = (float)(i * STATISTICS_LEVELS_PER_BUCKET) + (float)STATISTICS_LEVELS_PER_BUCKET * (rank - (float)count) / (float)bucketCount;
+
+            level = level < state->statistics.minimum[bin] ? state->statistics.minimum[bin] : level > state->statistics.maximum[bin] ? state->statistics.maximum[bin] : level;
+
+            return (uint8_t)level;
+
+        }
+
+        count += bucketCount;
+
+    }
+
+    return state->statistics.maximum[bin];
+
+}
+
+/* Public functions */
+
+void Statistics_initialise(statisticsState_t *state, uint32_t fftLength, uint32_t amplitudeNormalisingConstant) {
+
+    state->numberOfBins = MIN(fftLength / 2 + 1, STATISTICS_MAXIMUM_NUMBER_OF_BINS);
+
+    state->numberOfFrames = 0;
+
+    /* Conversion from log2 of the power to level steps */
+
+    state->levelScale = STATISTICS_STEPS_PER_DECIBEL * DECIBELS_PER_DOUBLING / (float)(1 << DECIBELS_LOG_FRACTION_BITS);
+
+    state->levelOffset = STATISTICS_STEPS_PER_DECIBEL * (10.0f * log10f(Decibels_powerNormalisation(amplitudeNormalisingConstant)) - STATISTICS_LEVEL_FLOOR);
+
+    memset(state->histograms, 0, sizeof(state->histograms));
+
+    memset(state->powerSum, 0, sizeof(state->powerSum));
+
+    memset(&state->statistics, 0, sizeof(statistics_t));
+
+    memset(state->statistics.minimum, UINT8_MAX, sizeof(state->statistics.minimum));
+
+}
+
+void Statistics_update(statisticsState_t *state, float *fftBuffer) {
+
+    uint8_t *minimum = state->statistics.minimum;
+
+    uint8_t *maximum = state->statistics.maximum;
+
+    for (uint32_t i = 0; i < state->numberOfBins; i += 1) {
+
+        float power = fftBuffer[2*i] * fftBuffer[2*i] + fftBuffer[2*i+1] * fftBuffer[2*i+1];
+
+        uint8_t level = quantiseLevel(state, power);
+
+        state->histograms[i][level / STATISTICS_LEVELS_PER_BUCKET] += 1;
+
+        state->powerSum[i] += power;
+
+        if (level < minimum[i]) minimum[i] = level;
+
+        if (level > maximum[i]) maximum[i] = level;
+
+    }
+
+    state->numberOfFrames += 1;
+
+}
+
+void Statistics_calculate(statisticsState_t *state) {
+
+    statistics_t *statistics = &state->statistics;
+
+    statistics->numberOfFrames = MIN(state->numberOfFrames, UINT16_MAX);
+
+    if (state->numberOfFrames == 0) {
+
+        memset(statistics, 0, sizeof(statistics_t));
+
+        return;
+
+    }
+
+    for (uint32_t i = 0; i < state->numberOfBins; i += 1) {
+
+        statistics->l90[i] = calculatePercentile(state, i, L90_PERCENTILE);
+
+        statistics->l50[i] = calculatePercentile(state, i, L50_PERCENTILE);
+
+        statistics->l10[i] = calculatePercentile(state, i, L10_PERCENTILE);
+
+        statistics->mean[i] = quantiseLevel(state, state->powerSum[i] / (float)state->numberOfFrames);
+
+    }
+
+}
@@ -0,0 +1,28 @@
+/****************************************************************************
+ * trace.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include "em_device.h"
+
+#include "trace.h"
+#include "audiomoth.h"
+
+/* Public functions */
+
+void Trace_enable(void) {
+
+    AudioMoth_setupSWOForPrint();
+
+    /* Enable the event ports and local timestamps clocked from the SWO clock so they do not change with the clock divider */
+
+    ITM->TER |= (1UL << TRACE_NUMBER_OF_EVENTS) - 1;
+
+    ITM->TCR |= ITM_TCR_TSENA_Msk | ITM_TCR_SWOENA_Msk;
+
+    /* The SWO setup stops the cycle counter used by the profile */
+
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+}
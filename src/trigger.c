@@ -0,0 +1,163 @@
+/****************************************************************************
+ * trigger.c
+ * openacousticdevices.info
+ * November 2024
+ *****************************************************************************/
+
+#include <math.h>
+
+#include "trigger.h"
+
+/* Useful macros */
+
+#define MAX(a, b)                               ((a) > (b) ? (a) : (b))
+
+/* Trigger settings in units of the summed sample differences of one buffer */
+
+static uint32_t numberOfSamples;
+
+static float fullScaleSum;
+
+static float thresholdRatio;
+
+static float minimumSum;
+
+/* Trigger state over the buffers of one acquisition. The interrupt handler updates these while the main loop runs */
+
+static int32_t previousSample;
+
+static float backgroundSum;
+
+static uint32_t maximumSum;
+
+static volatile uint32_t numberOfBuffers;
+
+static volatile uint32_t triggeredFrames;
+
+static volatile uint32_t skippedFrames;
+
+static volatile uint32_t droppedFrames;
+
+/* Private functions */
+
+static float sumToLevel(float sum) {
+
+    return sum > 0.0f ? 20.0f * log10f(sum / fullScaleSum) : TRIGGER_MINIMUM_LEVEL;
+
+}
+
+/* Public functions */
+
+void Trigger_initialise(uint32_t newNumberOfSamples, uint32_t amplitudeNormalisingConstant) {
+
+    numberOfSamples = newNumberOfSamples;
+
+    /* Levels are relative to a mean difference of full scale */
+
+    fullScaleSum = (float)numberOfSamples * (float)amplitudeNormalisingConstant;
+
+    thresholdRatio = powf(10.0f, TRIGGER_THRESHOLD / 20.0f);
+
+    minimumSum = fullScaleSum * powf(10.0f, TRIGGER_MINIMUM_LEVEL / 20.0f);
+
+    previousSample = 0;
+
+    backgroundSum = 0.0f;
+
+    maximumSum = 0;
+
+    numberOfBuffers = 0;
+
+    triggeredFrames = 0;
+
+    skippedFrames = 0;
+
+    droppedFrames = 0;
+
+}
+
+bool Trigger_update(int16_t *samples) {
+
+    /* The first difference lifts the high frequencies of echolocation calls over the low frequency background and removes any offset */
+
+    uint32_t sum = 0;
+
+    int32_t previous = previousSample;
+
+    for (uint32_t i = 0; i < numberOfSamples; i += 1) {
+
+        int32_t difference = samples[i] - previous;
+
+        sum += difference < 0 ? -difference : difference;
+
+        previous = samples[i];
+
+    }
+
+    previousSample = previous;
+
+    if (sum > maximumSum) maximumSum = sum;
+
+    /* The first buffers only set the background */
+
+    numberOfBuffers += 1;
+
+    if (numberOfBuffers <= TRIGGER_WARM_UP_BUFFERS) {
+
+        backgroundSum += ((float)sum - backgroundSum) / (float)numberOfBuffers;
+
+        return false;
+
+    }
+
+    bool triggered = (float)sum > MAX(minimumSum, thresholdRatio * backgroundSum);
+
+    /* The background follows the buffers which do not trigger, so calls do not raise it */
+
+    if (triggered) {
+
+        triggeredFrames += 1;
+
+    } else {
+
+        backgroundSum += ((float)sum - backgroundSum) / (float)(1 << TRIGGER_BACKGROUND_SHIFT);
+
+    }
+
+    return triggered;
+
+}
+
+void Trigger_skipFrame(void) {
+
+    skippedFrames += 1;
+
+}
+
+void Trigger_dropFrame(void) {
+
+    droppedFrames += 1;
+
+}
+
+void Trigger_calculate(trigger_t *trigger, uint32_t analysedFrames, uint32_t processingCycles) {
+
+    trigger->backgroundLevel = sumToLevel(backgroundSum);
+
+    trigger->maximumLevel = sumToLevel((float)maximumSum);
+
+    trigger->cyclesPerFrame = analysedFrames > 0 ? processingCycles / analysedFrames : 0;
+
+    trigger->numberOfBuffers = numberOfBuffers;
+
+    trigger->triggeredFrames = triggeredFrames;
+
+    trigger->analysedFrames = analysedFrames;
+
+    trigger->skippedFrames = skippedFrames;
+
+    trigger->droppedFrames = droppedFrames;
+
+    trigger->reserved = 0;
+
+}